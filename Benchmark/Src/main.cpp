@@ -0,0 +1,320 @@
+
+#include "ch32v00x_hal.h"
+#include "stopwatch.h"
+#include "flashlog.h"
+
+#define BENCH_USART_BAUDRATE                    (115200U)
+#define BENCH_TICK_CYCLES                       (8U)                    /*!< SysTick runs at HCLK/8 (HAL default) */
+#define BENCH_FLASH_PAGE_SIZE                   (0x400U)
+#define BENCH_FLASH_ADDR                        (FLASHLOG_BASE - BENCH_FLASH_PAGE_SIZE) /*!< 1KB page below the flash log, erased by the suite */
+#define BENCH_BUFFER_SIZE                       (256U)
+
+typedef void (*BENCH_FunctionTypeDef)(uint32_t index);
+
+/**
+ * @brief One line of the table: the function is called Iterations times in a row,
+ *        after Prepare (not measured) if any.
+ */
+typedef struct {
+    const char *Name;
+    BENCH_FunctionTypeDef Function;
+    void (*Prepare)(void);
+    uint32_t Iterations;
+    uint32_t Units;                             /*!< Units (e.g. bytes) processed by each call */
+    bool Once;                                  /*!< Only measured by the first run after reset (flash wear) */
+} BENCH_CaseTypeDef;
+
+static_assert((BENCH_FLASH_ADDR % BENCH_FLASH_PAGE_SIZE) == 0U, "The benchmark flash page must be aligned on 1KB");
+static_assert((BENCH_FLASH_ADDR + BENCH_FLASH_PAGE_SIZE <= EEPROM_BASE) ||
+              (BENCH_FLASH_ADDR >= EEPROM_BASE + EEPROM_SECTOR_COUNT * EEPROM_SECTOR_SIZE),
+              "The benchmark flash page overlaps the EEPROM emulation sectors");
+static_assert((BENCH_FLASH_ADDR + BENCH_FLASH_PAGE_SIZE <= FLASHLOG_BASE) || (BENCH_FLASH_ADDR >= FLASHLOG_BASE + FLASHLOG_SIZE),
+              "The benchmark flash page overlaps the flash log");
+static_assert(BENCH_FLASH_ADDR >= FLASH_NVM_BASE, "The benchmark flash page must be kept out of the image (NVM_SIZE)");
+
+constexpr RCC_ProfileTypeDef BENCH_PROFILE = RCC_Profile(RCC_SYSCLKSRC_PLL);
+
+static uint32_t BENCH_Src[BENCH_BUFFER_SIZE / 4U];
+static uint32_t BENCH_Dest[BENCH_BUFFER_SIZE / 4U];
+static volatile uint32_t BENCH_Sink;
+static volatile uint32_t BENCH_IrqStamp;
+static volatile bool BENCH_IrqDone;
+
+/**
+ * @brief  Interrupt handler for the software interrupt, used by BENCH_IrqLatency.
+ * @retval None.
+ */
+extern "C" __INTERRUPT void SW_Handler(void) {
+    BENCH_IrqStamp = SysTick->CNT;
+    BENCH_IrqDone = true;
+}
+
+static void BENCH_Empty(uint32_t index) {
+    (void)index;
+}
+
+static void BENCH_GpioToggle(uint32_t index) {
+    (void)index;
+    GPIOC.TogglePin(GPIO_PIN_0);
+}
+
+static void BENCH_GpioWrite(uint32_t index) {
+    GPIOC.WritePin(GPIO_PIN_0, (index & 0x01U) ? GPIO_STATE_SET : GPIO_STATE_RESET);
+}
+
+static void BENCH_GpioSetMode(uint32_t index) {
+    (void)index;
+    GPIOC.SetMode(GPIO_PIN_0, GPIO_MODE_OUTPUT_PP);
+}
+
+static void BENCH_SpiTransmit(uint32_t index) {
+    (void)index;
+    SPI1.Transmit((uint8_t *)BENCH_Src, 16U);
+}
+
+static void BENCH_UsartTransmit(uint32_t index) {
+    static const char line[] = "#bench\r\n";   /* Comment line, skipped by the table parsers */
+    (void)index;
+    USART1.Transmit((uint8_t *)line, sizeof(line) - 1U);
+}
+
+static void BENCH_UsartFlush(void) {
+    while(!(USART1.REGS.STATR & USART_STATR_TC));
+}
+
+static void BENCH_MemCopy16(uint32_t index) {
+    (void)index;
+    DMA1.CHANNEL1.MemCopy(BENCH_Src, BENCH_Dest, 16U);
+}
+
+static void BENCH_MemCopy64(uint32_t index) {
+    (void)index;
+    DMA1.CHANNEL1.MemCopy(BENCH_Src, BENCH_Dest, 64U);
+}
+
+static void BENCH_MemCopy256(uint32_t index) {
+    (void)index;
+    DMA1.CHANNEL1.MemCopy(BENCH_Src, BENCH_Dest, 256U);
+}
+
+static void BENCH_FlashErase(void) {
+    FLASH.ErasePage(BENCH_FLASH_ADDR, FLASH_ERASE_1KB);
+}
+
+static void BENCH_FlashWrite(uint32_t index) {
+    FLASH.WriteData(BENCH_FLASH_ADDR + (index * 64U), BENCH_Src, 64U);
+}
+
+static void BENCH_AdcConvert(uint32_t index) {
+    (void)index;
+    BENCH_Sink = ADC1.Regular.Convert(ADC_CHANNEL_0);
+}
+
+static void BENCH_GetTickUs(uint32_t index) {
+    (void)index;
+    BENCH_Sink = HAL.GetTickUs();
+}
+
+static void BENCH_GetTickMs(uint32_t index) {
+    (void)index;
+    BENCH_Sink = HAL.GetTickMs();
+}
+
+static void BENCH_TicksToUs(uint32_t index) {
+    BENCH_Sink = HAL.TicksToUs(index * 1000U);
+}
+
+static void BENCH_UsToTicks(uint32_t index) {
+    BENCH_Sink = HAL.UsToTicks(index * 1000U);
+}
+
+static const BENCH_CaseTypeDef BENCH_Cases[] = {
+    {"gpio_toggle",     BENCH_GpioToggle,       NULL_PTR,           256U,   1U,     false},
+    {"gpio_write",      BENCH_GpioWrite,        NULL_PTR,           256U,   1U,     false},
+    {"gpio_setmode",    BENCH_GpioSetMode,      NULL_PTR,           256U,   1U,     false},
+    {"spi_transmit",    BENCH_SpiTransmit,      NULL_PTR,           16U,    16U,    false},
+    {"usart_transmit",  BENCH_UsartTransmit,    BENCH_UsartFlush,   4U,     8U,     false},
+    {"dma_memcopy_16",  BENCH_MemCopy16,        NULL_PTR,           64U,    16U,    false},
+    {"dma_memcopy_64",  BENCH_MemCopy64,        NULL_PTR,           64U,    64U,    false},
+    {"dma_memcopy_256", BENCH_MemCopy256,       NULL_PTR,           16U,    256U,   false},
+    {"flash_write_64",  BENCH_FlashWrite,       BENCH_FlashErase,   16U,    64U,    true},
+    {"adc_convert",     BENCH_AdcConvert,       NULL_PTR,           64U,    1U,     false},
+    {"tick_get_us",     BENCH_GetTickUs,        NULL_PTR,           256U,   1U,     false},
+    {"tick_get_ms",     BENCH_GetTickMs,        NULL_PTR,           256U,   1U,     false},
+    {"tick_to_us",      BENCH_TicksToUs,        NULL_PTR,           256U,   1U,     false},
+    {"us_to_tick",      BENCH_UsToTicks,        NULL_PTR,           256U,   1U,     false},
+};
+
+/**
+ * @brief  Measure the interrupt entry latency with the software interrupt.
+ * @param  fast true to enter the handler through a VTF channel, false through the vector table.
+ * @note   SysTick is clocked from HCLK during the measurement, so the HAL tick runs faster
+ *         for a few microseconds. The result includes the SysTick reads and the pending request.
+ * @retval Latency in HCLK cycles, 0 if no VTF channel is available.
+ */
+static uint32_t BENCH_IrqLatency(bool fast) {
+    uint32_t ctlr = SysTick->CTLR;
+    uint32_t start;
+
+    if(fast && (HAL.SetFastIRQ(Software_IRQn, SW_Handler) != HAL_OK))
+        return 0U;
+    BENCH_IrqDone = false;
+    NVIC_EnableIRQ(Software_IRQn);
+    SysTick->CTLR = ctlr | STK_CTLR_STCLK;
+    start = SysTick->CNT;
+    NVIC_SetPendingIRQ(Software_IRQn);
+    while(!BENCH_IrqDone);
+    SysTick->CTLR = ctlr;
+    NVIC_DisableIRQ(Software_IRQn);
+    if(fast)
+        HAL.ClearFastIRQ(Software_IRQn);
+    return BENCH_IrqStamp - start;
+}
+
+/**
+ * @brief  Measure the cycles taken by a number of calls in a row.
+ * @param  function function to be measured.
+ * @param  iterations number of calls.
+ * @retval Total number of HCLK cycles, loop overhead included.
+ */
+static uint32_t BENCH_Measure(BENCH_FunctionTypeDef function, uint32_t iterations) {
+    Stopwatch stopwatch;
+    uint32_t ticks;
+    stopwatch.Start();
+    for(uint32_t i = 0U; i < iterations; i++)
+        function(i);
+    ticks = stopwatch.ElapsedTicks();
+    stopwatch.Stop();
+    return ticks * BENCH_TICK_CYCLES;
+}
+
+static uint32_t BENCH_Format(char *buff, uint32_t value) {
+    char digits[10];
+    uint32_t length = 0U;
+    uint32_t index = 0U;
+    do {
+        digits[length++] = '0' + (value % 10U);
+        value /= 10U;
+    } while(value);
+    while(length)
+        buff[index++] = digits[--length];
+    return index;
+}
+
+static void BENCH_Print(const char *text) {
+    uint32_t length = 0U;
+    while(text[length])
+        length++;
+    USART1.Transmit((uint8_t *)text, length);
+}
+
+static void BENCH_PrintRow(const char *name, uint32_t iterations, uint32_t cycles, uint32_t units) {
+    char line[80];
+    uint32_t length = 0U;
+    for(; *name; name++)
+        line[length++] = *name;
+    line[length++] = ',';
+    length += BENCH_Format(&line[length], iterations);
+    line[length++] = ',';
+    length += BENCH_Format(&line[length], cycles);
+    line[length++] = ',';
+    length += BENCH_Format(&line[length], units);
+    line[length++] = ',';
+    length += BENCH_Format(&line[length], cycles / units);
+    line[length++] = '\r';
+    line[length++] = '\n';
+    line[length] = '\0';
+    BENCH_Print(line);
+}
+
+/**
+ * @brief  Run all the cases and send the results as a CSV table.
+ * @note   The table starts after the "# hal-bench" line and ends with "# end". Each row
+ *         gives the cycles per call and per unit (e.g. per byte), the overhead of the
+ *         benchmark loop being removed. The irq_latency rows give the cycles from a
+ *         software interrupt request to its handler. The startup_* rows give the cycles
+ *         spent by the startup code before main, measured once at reset.
+ * @param  first true for the first run after reset, the cases marked Once (flash
+ *         erase and program) are skipped by the next runs to spare the flash.
+ * @retval None.
+ */
+static void BENCH_Run(bool first) {
+    char line[80];
+    uint32_t length;
+    uint32_t overhead = BENCH_Measure(BENCH_Empty, 256U) / 256U;
+
+    length = 0U;
+    for(const char *text = "# hal-bench,hclk="; *text; text++)
+        line[length++] = *text;
+    length += BENCH_Format(&line[length], RCC.HCLK.GetFreq());
+    line[length] = '\0';
+    BENCH_Print(line);
+    BENCH_Print("\r\nname,iterations,cycles_per_call,units_per_call,cycles_per_unit\r\n");
+
+    for(uint32_t i = 0U; i < LENGTH(BENCH_Cases); i++) {
+        const BENCH_CaseTypeDef &bench = BENCH_Cases[i];
+        uint32_t cycles;
+        if(bench.Once && !first)
+            continue;
+        BENCH_UsartFlush();
+        if(bench.Prepare != NULL_PTR)
+            bench.Prepare();
+        cycles = BENCH_Measure(bench.Function, bench.Iterations) / bench.Iterations;
+        cycles = (cycles > overhead) ? (cycles - overhead) : 0U;
+        BENCH_PrintRow(bench.Name, bench.Iterations, cycles, bench.Units);
+    }
+    BENCH_UsartFlush();
+    BENCH_PrintRow("irq_latency", 1U, BENCH_IrqLatency(false), 1U);
+    BENCH_PrintRow("irq_latency_vtf", 1U, BENCH_IrqLatency(true), 1U);
+    BENCH_PrintRow("startup_to_main", 1U, SystemStartupCycles, 1U);
+    BENCH_PrintRow("startup_ctors", 1U, SystemCtorCycles, 1U);
+    BENCH_Print("# end\r\n");
+}
+
+static void BENCH_Init(void) {
+    HAL.Init();
+    RCC.SetProfile(BENCH_PROFILE);
+
+    /* USART1: TX on PD5, results table */
+    GPIOD.EnableClock();
+    GPIOD.SetMode(GPIO_PIN_5, GPIO_MODE_AF_PP);
+    USART1.EnableClock();
+    USART1.BaudRate.SetValue<BENCH_PROFILE.HCLK, BENCH_USART_BAUDRATE>();
+    USART1.TxMode.Enable();
+    USART1.Enable();
+
+    GPIOC.EnableClock();
+    GPIOC.SetMode(GPIO_PIN_0, GPIO_MODE_OUTPUT_PP);
+
+    /* SPI1 master, software NSS, pins left unconfigured */
+    SPI1.EnableClock();
+    SPI1.Mode.MasterFullDuplex();
+    SPI1.NSS.Disable();
+    SPI1.NSS.ActiveHight();
+    SPI1.Enable();
+
+    DMA1.EnableClock();
+    DMA1.CHANNEL1.SetMINC(ENABLE);
+    DMA1.CHANNEL1.SetPINC(ENABLE);
+
+    ADC1.EnableClock();
+    ADC1.SetPrescaler(ADC_CLK_AHB_DIV2);
+
+    for(uint32_t i = 0U; i < LENGTH(BENCH_Src); i++)
+        BENCH_Src[i] = i * 0x01010101UL;
+}
+
+int main(void) {
+    BENCH_Init();
+#ifdef HAL_SIMULATOR
+    BENCH_Run(true);
+    BENCH_UsartFlush();
+    return 0;
+#else
+    BENCH_Run(true);
+    while(1) {
+        HAL.DelayMs(2000);
+        BENCH_Run(false);
+    }
+#endif /* HAL_SIMULATOR */
+}
@@ -0,0 +1,73 @@
+
+#ifndef __BOOTLOADER_H
+#define __BOOTLOADER_H
+
+#include "ch32v00x_hal.h"
+
+/**
+ * @brief Flash layout shared by the bootloader (Linker/ch32v00x_boot.ld) and the application
+ *        linked with BOOTLOADER=1 (Linker/ch32v00x_app.ld). Both must be built with the same NVM_SIZE.
+ */
+#define BOOT_SIZE                               (0x1000U)                           /*!< Flash reserved for the bootloader */
+#define BOOT_APP_ENTRY                          (BOOT_SIZE)                         /*!< Application reset entry (link address) */
+#define BOOT_APP_BASE                           (FLASH_BASE + BOOT_SIZE)
+#define BOOT_APP_END                            (FLASH_NVM_BASE)                    /*!< Flash log and EEPROM emulation above */
+#define BOOT_INFO_ADDR                          (BOOT_APP_END - BOOT_PAGE_SIZE)     /*!< Image information page */
+#define BOOT_APP_SIZE                           (BOOT_INFO_ADDR - BOOT_APP_BASE)    /*!< Maximum application image size */
+#define BOOT_PAGE_SIZE                          (64U)
+
+#define BOOT_INFO_MAGIC                         (0xB007A55AUL)
+
+#ifndef BOOT_TIMEOUT_MS
+#define BOOT_TIMEOUT_MS                         (300U)          /*!< Time waiting for a host before starting the application */
+#endif
+
+#ifndef BOOT_FRAME_TIMEOUT_MS
+#define BOOT_FRAME_TIMEOUT_MS                   (50U)           /*!< Maximum gap inside a frame before it is dropped */
+#endif
+
+#ifndef BOOT_USART_BAUDRATE
+#define BOOT_USART_BAUDRATE                     (115200U)
+#endif
+
+#ifndef BOOT_I2C_ADDRESS
+#define BOOT_I2C_ADDRESS                        (0x52U)         /*!< 7-bit slave address */
+#endif
+
+#define BOOT_ACK                                (0x79U)
+#define BOOT_NACK                               (0x1FU)
+
+typedef enum {
+    BOOT_CMD_SYNC = 'S',                                        /*!< Enter the bootloader, must be the first frame */
+    BOOT_CMD_ERASE = 'E',                                       /*!< Erase the application area and its information page */
+    BOOT_CMD_WRITE = 'W',                                       /*!< Program Data to the page at Address */
+    BOOT_CMD_VERIFY = 'V',                                      /*!< Check the image of Address bytes against the CRC16 in Data[0..1] */
+    BOOT_CMD_GO = 'G'                                           /*!< Start the application */
+} BOOT_CommandTypeDef;
+
+/**
+ * @brief Frame sent by the host, always BOOT_FRAME_SIZE bytes (little endian).
+ *        The device answers each frame with one byte, BOOT_ACK or BOOT_NACK.
+ * @note  Crc is the CRC16 (CRC16_Calc) of Command, Reserved, Address and Data.
+ */
+typedef struct {
+    uint8_t Command;
+    uint8_t Reserved;
+    uint16_t Crc;
+    uint32_t Address;
+    uint8_t Data[BOOT_PAGE_SIZE];
+} BOOT_FrameTypeDef;
+
+#define BOOT_FRAME_SIZE                         (sizeof(BOOT_FrameTypeDef))
+
+/**
+ * @brief Image information stored at BOOT_INFO_ADDR after a successful verify.
+ */
+typedef struct {
+    uint32_t Magic;
+    uint32_t Size;
+    uint16_t Crc;
+    uint16_t Reserved;
+} BOOT_InfoTypeDef;
+
+#endif /* __BOOTLOADER_H */
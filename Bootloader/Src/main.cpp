@@ -0,0 +1,225 @@
+
+#include "ch32v00x_hal.h"
+#include "bootloader.h"
+#include "crc.h"
+
+typedef enum {
+    BOOT_ITF_NONE = 0U,
+    BOOT_ITF_USART,
+    BOOT_ITF_I2C
+} BOOT_InterfaceTypeDef;
+
+constexpr RCC_ProfileTypeDef BOOT_PROFILE = RCC_Profile(RCC_SYSCLKSRC_PLL);
+
+static BOOT_FrameTypeDef BOOT_Frame;
+static uint32_t BOOT_RxCount;
+static uint32_t BOOT_RxTick;
+
+static bool BOOT_IsAppValid(void) {
+    const BOOT_InfoTypeDef *info = (const BOOT_InfoTypeDef *)BOOT_INFO_ADDR;
+    if((info->Magic != BOOT_INFO_MAGIC) || (info->Size == 0U) || (info->Size > BOOT_APP_SIZE))
+        return false;
+    return CRC16_Calc((const void *)BOOT_APP_BASE, info->Size) == info->Crc;
+}
+
+static void BOOT_Init(void) {
+    HAL.Init();
+    RCC.SetProfile(BOOT_PROFILE);
+
+    /* USART1: TX on PD5, RX on PD6, frames received by DMA1 channel 5 */
+    GPIOD.EnableClock();
+    GPIOD.SetMode(GPIO_PIN_5, GPIO_MODE_AF_PP);
+    GPIOD.SetMode(GPIO_PIN_6, GPIO_MODE_INPUT_PU);
+    USART1.EnableClock();
+    USART1.BaudRate.SetValue<BOOT_PROFILE.HCLK, BOOT_USART_BAUDRATE>();
+    USART1.RxMode.Enable();
+    USART1.TxMode.Enable();
+    USART1.REGS.CTLR3 |= USART_CTLR3_DMAR;
+    USART1.Enable();
+    DMA1.EnableClock();
+    DMA1.CHANNEL5.SetMINC(ENABLE);
+
+    /* I2C1 slave: SDA on PC1, SCL on PC2 */
+    GPIOC.EnableClock();
+    GPIOC.SetMode(GPIO_PIN_1 | GPIO_PIN_2, GPIO_MODE_AF_OD);
+    I2C1.EnableClock();
+    I2C1.Clock.SetBaudRate<BOOT_PROFILE.HCLK, I2C_BAUDRATE_400KHz>();
+    I2C1.Slave.SetAddress(BOOT_I2C_ADDRESS << 1U);
+    I2C1.Enable();
+    I2C1.REGS.CTLR1 |= I2C_CTLR1_ACK;
+}
+
+/**
+ * @brief  Start receiving the next frame from USART1 in background.
+ * @note   The frame buffer is reused, so this is only called once the previous frame
+ *         has been processed.
+ * @retval None.
+ */
+static void BOOT_UsartStart(void) {
+    DMA1.CHANNEL5.Stop();
+    DMA1.CHANNEL5.Setup((uint8_t *)&USART1.REGS.DATAR, (uint8_t *)&BOOT_Frame, BOOT_FRAME_SIZE);
+    BOOT_RxCount = BOOT_FRAME_SIZE;
+    BOOT_RxTick = HAL.GetTickMs();
+}
+
+/**
+ * @brief  Check whether a complete frame has been received.
+ * @param  itf specifies the interface to poll, BOOT_ITF_NONE polls both of them.
+ * @note   A partial USART frame is dropped after BOOT_FRAME_TIMEOUT_MS without data,
+ *         so the host can resynchronize by resending the frame.
+ * @retval Interface the frame was received from, BOOT_ITF_NONE if there is no frame yet.
+ */
+static BOOT_InterfaceTypeDef BOOT_Poll(BOOT_InterfaceTypeDef itf) {
+    if(itf != BOOT_ITF_I2C) {
+        uint32_t count = DMA1.CHANNEL5.REGS.CNTR;
+        if(count == 0U)
+            return BOOT_ITF_USART;
+        if(count != BOOT_RxCount) {
+            BOOT_RxCount = count;
+            BOOT_RxTick = HAL.GetTickMs();
+        }
+        else if((count != BOOT_FRAME_SIZE) && ((HAL.GetTickMs() - BOOT_RxTick) >= BOOT_FRAME_TIMEOUT_MS))
+            BOOT_UsartStart();
+    }
+    if((itf != BOOT_ITF_USART) && (I2C1.REGS.STAR1 & I2C_STAR1_ADDR)) {
+        HAL_StatusTypeDef status = I2C1.Slave.Receive((uint8_t *)&BOOT_Frame, BOOT_FRAME_SIZE, BOOT_FRAME_TIMEOUT_MS);
+        I2C1.REGS.CTLR1 |= I2C_CTLR1_ACK;
+        if(status == HAL_OK)
+            return BOOT_ITF_I2C;
+    }
+    return BOOT_ITF_NONE;
+}
+
+static bool BOOT_CheckFrame(void) {
+    uint16_t crc = CRC16_Calc(&BOOT_Frame, 2U);
+    crc = CRC16_Calc(&BOOT_Frame.Address, BOOT_FRAME_SIZE - 4U, crc);
+    return crc == BOOT_Frame.Crc;
+}
+
+static uint8_t BOOT_Erase(void) {
+    for(uint32_t address = BOOT_APP_BASE; address < BOOT_APP_END; address += 1024U) {
+        if(FLASH.ErasePage(address, FLASH_ERASE_1KB) != HAL_OK)
+            return BOOT_NACK;
+    }
+    return BOOT_ACK;
+}
+
+/**
+ * @brief  Program the page carried by the current frame.
+ * @note   The bootloader runs from flash and instruction fetches stall while a page
+ *         is programmed, so the page is written synchronously before the reply.
+ *         The host sends the next frame only once it has received the reply.
+ * @retval BOOT_ACK or BOOT_NACK.
+ */
+static uint8_t BOOT_Write(void) {
+    uint32_t address = BOOT_Frame.Address;
+    if((address % BOOT_PAGE_SIZE) || (address < BOOT_APP_BASE) || (address >= BOOT_INFO_ADDR))
+        return BOOT_NACK;
+    if(FLASH.WriteData(address, BOOT_Frame.Data, BOOT_PAGE_SIZE) != HAL_OK)
+        return BOOT_NACK;
+    return BOOT_ACK;
+}
+
+static uint8_t BOOT_Verify(void) {
+    BOOT_InfoTypeDef info;
+    info.Magic = BOOT_INFO_MAGIC;
+    info.Size = BOOT_Frame.Address;
+    info.Crc = BOOT_Frame.Data[0] | (BOOT_Frame.Data[1] << 8U);
+    info.Reserved = 0xFFFFU;
+    if((info.Size == 0U) || (info.Size > BOOT_APP_SIZE))
+        return BOOT_NACK;
+    if(CRC16_Calc((const void *)BOOT_APP_BASE, info.Size) != info.Crc)
+        return BOOT_NACK;
+    if(FLASH.WriteData(BOOT_INFO_ADDR, &info, sizeof(info)) != HAL_OK)
+        return BOOT_NACK;
+    return BOOT_IsAppValid() ? BOOT_ACK : BOOT_NACK;
+}
+
+static uint8_t BOOT_Process(void) {
+    if(!BOOT_CheckFrame())
+        return BOOT_NACK;
+    switch(BOOT_Frame.Command) {
+        case BOOT_CMD_SYNC:
+            return BOOT_ACK;
+        case BOOT_CMD_ERASE:
+            return BOOT_Erase();
+        case BOOT_CMD_WRITE:
+            return BOOT_Write();
+        case BOOT_CMD_VERIFY:
+            return BOOT_Verify();
+        case BOOT_CMD_GO:
+            return BOOT_IsAppValid() ? BOOT_ACK : BOOT_NACK;
+        default:
+            return BOOT_NACK;
+    }
+}
+
+static void BOOT_Reply(BOOT_InterfaceTypeDef itf, uint8_t reply) {
+    if(itf == BOOT_ITF_USART) {
+        USART1.Transmit(&reply, 1U, BOOT_FRAME_TIMEOUT_MS);
+        while(!(USART1.REGS.STATR & USART_STATR_TC));
+    }
+    else
+        I2C1.Slave.Transmit(&reply, 1U, BOOT_FRAME_TIMEOUT_MS);
+}
+
+/**
+ * @brief  Put the peripherals used by the bootloader back to their reset state
+ *         and start the application from its reset entry.
+ * @note   The application startup code sets up its own vector table (mtvec),
+ *         stack and data before enabling interrupts again.
+ * @retval None.
+ */
+static void BOOT_JumpToApp(void) {
+    __disable_irq();
+    SysTick->CTLR = 0U;
+    DMA1.DeInit();
+    DMA1.DisableClock();
+    USART1.DeInit();
+    USART1.DisableClock();
+    I2C1.DeInit();
+    I2C1.DisableClock();
+    GPIOC.DeInit();
+    GPIOD.DeInit();
+    GPIOC.DisableClock();
+    GPIOD.DisableClock();
+    RCC.DeInit();
+    ((void (*)(void))BOOT_APP_ENTRY)();
+}
+
+int main(void) {
+    BOOT_InterfaceTypeDef itf = BOOT_ITF_NONE;
+    uint32_t startTick;
+    uint8_t command;
+    uint8_t reply;
+    bool appValid;
+
+    BOOT_Init();
+    appValid = BOOT_IsAppValid();
+    BOOT_UsartStart();
+    startTick = HAL.GetTickMs();
+    while(itf == BOOT_ITF_NONE) {
+        itf = BOOT_Poll(BOOT_ITF_NONE);
+        if((itf != BOOT_ITF_NONE) && (!BOOT_CheckFrame() || (BOOT_Frame.Command != BOOT_CMD_SYNC))) {
+            itf = BOOT_ITF_NONE;
+            BOOT_UsartStart();
+        }
+        else if((itf == BOOT_ITF_NONE) && ((HAL.GetTickMs() - startTick) >= BOOT_TIMEOUT_MS) && appValid)
+            BOOT_JumpToApp();
+    }
+    if(itf == BOOT_ITF_USART)
+        BOOT_UsartStart();
+    BOOT_Reply(itf, BOOT_ACK);
+
+    while(1) {
+        if(BOOT_Poll(itf) == BOOT_ITF_NONE)
+            continue;
+        command = BOOT_Frame.Command;
+        reply = BOOT_Process();
+        if(itf == BOOT_ITF_USART)
+            BOOT_UsartStart();
+        BOOT_Reply(itf, reply);
+        if((reply == BOOT_ACK) && (command == BOOT_CMD_GO))
+            BOOT_JumpToApp();
+    }
+}
@@ -2,6 +2,7 @@
 #define __CH32V00x_HAL_H
 
 #include "ch32v00x.h"
+#include "ch32v00x_hal_time.h"
 
 #ifndef NULL
 #define NULL            (0U)
@@ -13,6 +14,13 @@
 
 #define LENGTH(array)   (sizeof(array) / sizeof(array[0]))
 
+/**
+ * @brief Bus address of an object, as written to the peripheral address registers or
+ *        passed to the FLASH functions. The cast goes through uintptr_t so that the host
+ *        build, which keeps all the objects below 4GB, does not need -fpermissive.
+ */
+#define HAL_ADDRESS(pointer)    ((uint32_t)(uintptr_t)(pointer))
+
 typedef enum  {
     HAL_OK = 0x00U,
     HAL_ERROR = 0x01U,
@@ -24,6 +32,35 @@ typedef FunctionalState HAL_StateTypeDef;
 
 typedef FlagStatus HAL_FlagStatusTypeDef;
 
+/**
+ * @brief  Compute at compile time the relative error between an actual and a target rate.
+ * @param  actual actual rate.
+ * @param  target target rate.
+ * @retval Error in ppm (parts per million).
+ */
+constexpr uint32_t HAL_GetErrorPpm(uint32_t actual, uint32_t target) {
+    return (uint32_t)((((actual > target) ? (actual - target) : (target - actual)) * 1000000ULL) / target);
+}
+
+/**
+ * @brief Interrupt priority for NVIC_SetPriority. Bit 7 selects the preemption level and
+ *        bit 6 the sub-priority inside a level, lower values have higher priority.
+ *        The HAL drivers use the <MODULE>_IRQ_PRIORITY values, which can be overridden
+ *        in ch32v00x_hal_conf.h.
+ */
+#define HAL_IRQ_PRIORITY(preempt, sub)          ((uint8_t)((((preempt) & 0x01U) << 7U) | (((sub) & 0x01U) << 6U)))
+#define HAL_IRQ_PRIORITY_HIGH                   HAL_IRQ_PRIORITY(0U, 0U)    /*!< Preempts HAL_IRQ_PRIORITY_LOW handlers */
+#define HAL_IRQ_PRIORITY_LOW                    HAL_IRQ_PRIORITY(1U, 0U)
+
+#define HAL_FAST_IRQ_COUNT                      (2U)                        /*!< Number of VTF channels */
+
+typedef void (*HAL_IRQHandlerTypeDef)(void);
+
+typedef enum {
+    HAL_TICKCLK_HCLK_DIV8 = 0U,                 /*!< SysTick clocked from HCLK/8 (default) */
+    HAL_TICKCLK_HCLK = 1U                       /*!< SysTick clocked from HCLK, single cycle resolution */
+} HAL_TickClkTypeDef;
+
 class HAL_TypeDef {
 public:
     void Init(void);
@@ -31,10 +68,17 @@ public:
     uint32_t GetTickMs(void);
     void DelayUs(uint32_t time);
     void DelayMs(uint32_t time);
+    void Sleep(uint32_t ticks);
+    uint32_t TicksToUs(uint32_t ticks);
+    uint32_t TicksToMs(uint32_t ticks);
+    uint32_t UsToTicks(uint32_t time);
+    uint32_t MsToTicks(uint32_t time);
     void EnabelTickIRQ(uint32_t interval);
     void DisableTickIRQ(void);
+    void SetTickClock(HAL_TickClkTypeDef clock);
+    HAL_StatusTypeDef SetFastIRQ(IRQn_Type irq, HAL_IRQHandlerTypeDef handler, uint8_t priority = HAL_IRQ_PRIORITY_HIGH);
+    void ClearFastIRQ(IRQn_Type irq);
 private:
-    uint32_t TickIntervalMs;
     HAL_TypeDef(void) = delete;
     HAL_TypeDef(const HAL_TypeDef &) = delete;
     void operator=(const HAL_TypeDef &) = delete;
@@ -42,14 +86,50 @@ private:
 
 #define HAL             (*(HAL_TypeDef *)0U)
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Interrupt handlers implemented by the HAL, C linkage replaces the weak startup handlers */
+void SysTick_Handler(void);
+void EXTI7_0_IRQHandler(void);
+void FLASH_IRQHandler(void);
+void WWDG_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+void HAL_TickProfileUpdate(uint32_t hclk);
+
 #if __has_include("ch32v00x_hal_conf.h")
 #include "ch32v00x_hal_conf.h"
 #endif
 
+/**
+ * @brief Trivial register accessors (GPIO pins, SPI/USART/DMA enable and mode bits,
+ *        peripheral clocks) are defined in the <module>_inline.h headers. When
+ *        HAL_INLINE_ACCESSORS is not 0 they are force-inlined at every call site, so
+ *        a call costs the register access only and peripheral checks such as
+ *        this == &SPI1 fold at compile time. Otherwise they are compiled once in the
+ *        driver sources.
+ */
+#ifndef HAL_INLINE_ACCESSORS
+#define HAL_INLINE_ACCESSORS                    (0U)
+#endif /* HAL_INLINE_ACCESSORS */
+
+#if (HAL_INLINE_ACCESSORS != 0U)
+#define HAL_ACCESSOR                            __attribute__((always_inline)) __INLINE
+#else
+#define HAL_ACCESSOR
+#endif /* HAL_INLINE_ACCESSORS */
+
 #include "ch32v00x_hal_rcc.h"
 #include "ch32v00x_hal_gpio.h"
 #include "ch32v00x_hal_adc.h"
+#if __has_include("ch32v00x_hal_tim.h")
 #include "ch32v00x_hal_tim.h"
+#endif
 #include "ch32v00x_hal_afio.h"
 #include "ch32v00x_hal_exti.h"
 #include "ch32v00x_hal_flash.h"
@@ -60,6 +140,8 @@ private:
 #include "ch32v00x_hal_dma.h"
 #include "ch32v00x_hal_pwr.h"
 #include "ch32v00x_hal_iwdg.h"
+#include "ch32v00x_hal_wwdg.h"
 #include "ch32v00x_hal_esig.h"
+#include "ch32v00x_hal_irqstats.h"
 
 #endif /* __CH32V00x_HAL_H */
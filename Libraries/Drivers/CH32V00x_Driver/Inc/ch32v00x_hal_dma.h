@@ -77,4 +77,8 @@ private:
 
 #define DMA1            (*(DMA_TypeDef *)DMA1_BASE)
 
+#if (HAL_INLINE_ACCESSORS != 0U)
+#include "ch32v00x_hal_dma_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #endif /* __CH32V00x_HAL_DMA_H */
@@ -0,0 +1,48 @@
+
+#ifndef __CH32V00x_HAL_DMA_INLINE_H
+#define __CH32V00x_HAL_DMA_INLINE_H
+
+/* DMA accessors, inlined in ch32v00x_hal_dma.h when HAL_INLINE_ACCESSORS is enabled */
+
+/**
+ * @brief  Return current status according to the internal DMA channel
+ *         registers.
+ * @retval HAL status.
+ */
+HAL_ACCESSOR HAL_StatusTypeDef DMA_ChannelTypeDef::GetStatus(void) {
+    if(!(REGS.CFGR & DMA_CFGR_EN))
+        return HAL_OK;
+    else if(!(REGS.CFGR & DMA_CFGR_CIRC) && REGS.CNTR == 0)
+        return HAL_OK;
+    return HAL_BUSY;
+}
+
+/**
+ * @brief  Stop tranfer.
+ * @retval None.
+ */
+HAL_ACCESSOR void DMA_ChannelTypeDef::Stop(void) {
+    REGS.CFGR &= ~DMA_CFGR_EN;
+}
+
+/**
+ * @brief  Enable the DMA peripheral clock.
+ * @note   This function will use RCC module to enable clock for DMA peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void DMA_TypeDef::EnableClock(void) {
+    if(this == &DMA1)
+        RCC.REGS.AHBPCENR |= RCC_AHBPCENR_DMA1EN;
+}
+
+/**
+ * @brief  Disable the DMA peripheral clock.
+ * @note   This function will use RCC module to disable clock for DMA peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void DMA_TypeDef::DisableClock(void) {
+    if(this == &DMA1)
+        RCC.REGS.AHBPCENR &= ~RCC_AHBPCENR_DMA1EN;
+}
+
+#endif /* __CH32V00x_HAL_DMA_INLINE_H */
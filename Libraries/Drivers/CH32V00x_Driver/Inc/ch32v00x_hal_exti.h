@@ -36,6 +36,8 @@ typedef enum {
     EXTI_PORT_GPIOD = 3U
 } EXTI_PortTypeDef;
 
+typedef void (*EXTI_CallbackTypeDef)(uint32_t line);
+
 class EXTI_TypeDef {
 public:
     struct {
@@ -49,6 +51,7 @@ public:
     } REGS;
 public:
     void Init(EXTI_PortTypeDef port, uint32_t line, EXTI_ModeTypeDef mode = EXTI_MODE_INTERRUPT, EXTI_TriggerTypeDef trigger = EXTI_TRIGGER_CHANGE);
+    HAL_StatusTypeDef SetCallback(uint32_t line, EXTI_CallbackTypeDef callback, uint16_t debounceMs = 0U);
     void DeInit(uint32_t line = EXTI_LINE_ALL);
 private:
     EXTI_TypeDef(void) = delete;
@@ -58,4 +61,6 @@ private:
 
 #define EXTI            (*(EXTI_TypeDef *)EXTI_BASE)
 
+void HAL_EXTI_TickHandler(void);
+
 #endif /* __CH32V00x_HAL_EXTI_H */
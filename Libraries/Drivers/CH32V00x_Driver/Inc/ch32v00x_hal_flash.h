@@ -4,11 +4,45 @@
 
 #include "ch32v00x_hal.h"
 
+#ifndef FLASH_NVM_SIZE
+#define FLASH_NVM_SIZE          (0U)            /*!< Bytes at the top of the flash kept out of the application image */
+#endif /* FLASH_NVM_SIZE */
+
+#define FLASH_NVM_BASE          (FLASH_BASE + 0x4000U - FLASH_NVM_SIZE)
+
 typedef enum {
     FLASH_ERASE_64B = 0U,
     FLASH_ERASE_1KB = 1U
 } FLASH_EraseModeTypeDef;
 
+typedef enum {
+    FLASH_OB_RSTMODE_DELAY_128US = 0U,                          /*!< PD7 is the reset pin, 128us ignore delay */
+    FLASH_OB_RSTMODE_DELAY_1MS = 1U,                            /*!< PD7 is the reset pin, 1ms ignore delay */
+    FLASH_OB_RSTMODE_DELAY_12MS = 2U,                           /*!< PD7 is the reset pin, 12ms ignore delay */
+    FLASH_OB_RSTMODE_GPIO = 3U                                  /*!< Reset pin disabled, PD7 is a GPIO */
+} FLASH_OB_RstModeTypeDef;
+
+typedef enum {
+    FLASH_OB_BOOT_USER = 0U,                                    /*!< Start from the user code area after power-on */
+    FLASH_OB_BOOT_SYSTEM = 1U                                   /*!< Start from the system (BOOT) area after power-on */
+} FLASH_OB_BootModeTypeDef;
+
+/**
+ * @brief User option bytes, read with FLASH.GetOptionBytes and written back at once
+ *        with FLASH.SetOptionBytes.
+ */
+typedef struct {
+    FLASH_OB_RstModeTypeDef RstMode;
+    FLASH_OB_BootModeTypeDef BootMode;
+    bool IwdgHardware;                                          /*!< IWDG started by hardware after reset */
+    bool StandbyReset;                                          /*!< Entering standby mode generates a reset */
+    uint8_t Data0;
+    uint8_t Data1;
+    uint16_t WriteProtect;                                      /*!< Bit n set protects the 1KB sector n */
+} FLASH_OptionBytesTypeDef;
+
+typedef void (*FLASH_CallbackTypeDef)(HAL_StatusTypeDef status);
+
 class FLASH_TypeDef {
 public:
     struct {
@@ -29,7 +63,13 @@ public:
     } REGS;
 public:
     HAL_StatusTypeDef ErasePage(uint32_t address, FLASH_EraseModeTypeDef eraseMode);
+    HAL_StatusTypeDef ErasePageAsync(uint32_t address, FLASH_EraseModeTypeDef eraseMode, FLASH_CallbackTypeDef callback = NULL_PTR);
     HAL_StatusTypeDef WriteData(uint32_t address, void *data, uint32_t size);
+    HAL_StatusTypeDef WriteDataAsync(uint32_t address, const void *data, uint32_t size, FLASH_CallbackTypeDef callback = NULL_PTR);
+    bool IsBusy(void);
+    void GetOptionBytes(FLASH_OptionBytesTypeDef &optionBytes);
+    HAL_StatusTypeDef SetOptionBytes(const FLASH_OptionBytesTypeDef &optionBytes);
+    uint16_t GetWriteProtect(void);
 private:
     FLASH_TypeDef(void) = delete;
     FLASH_TypeDef(const FLASH_TypeDef &) = delete;
@@ -41,6 +81,10 @@ private:
     HAL_StatusTypeDef BuffReset(void);
     HAL_StatusTypeDef LoadWord(uint32_t address, uint32_t data);
     HAL_StatusTypeDef StartFastProgram(uint32_t address);
+    HAL_StatusTypeDef ProgramNextPage(void);
+    HAL_StatusTypeDef ProgramOptionByte(__IO uint16_t *address, uint8_t data);
+
+    friend void FLASH_IRQHandler(void);
 };
 
 #define FLASH           (*(FLASH_TypeDef *)FLASH_R_BASE)
@@ -80,4 +80,8 @@ private:
 #define GPIOC           (*(GPIO_TypeDef *)GPIOC_BASE)
 #define GPIOD           (*(GPIO_TypeDef *)GPIOD_BASE)
 
+#if (HAL_INLINE_ACCESSORS != 0U)
+#include "ch32v00x_hal_gpio_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #endif /* __CH32V00x_HAL_GPIO_H */
@@ -0,0 +1,99 @@
+
+#ifndef __CH32V00x_HAL_GPIO_INLINE_H
+#define __CH32V00x_HAL_GPIO_INLINE_H
+
+/* GPIO accessors, inlined in ch32v00x_hal_gpio.h when HAL_INLINE_ACCESSORS is enabled */
+
+/**
+ * @brief  Enable the GPIO peripheral clock.
+ * @note   This function will use RCC module to enable clock for GPIO peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::EnableClock(void) {
+    if(this == &GPIOA)
+        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_IOPAEN;
+    else if(this == &GPIOC)
+        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_IOPCEN;
+    else if(this == &GPIOD)
+        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_IOPDEN;
+}
+
+/**
+ * @brief  Disable the GPIO peripheral clock.
+ * @note   This function will use RCC module to disable clock for GPIO peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::DisableClock(void) {
+    if(this == &GPIOA)
+        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_IOPAEN;
+    else if(this == &GPIOC)
+        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_IOPCEN;
+    else if(this == &GPIOD)
+        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_IOPDEN;
+}
+
+/**
+ * @brief  Read the specified input port pin.
+ * @param  pin specifies the port bit to read.
+ *         This parameter can be GPIO_PIN_x where x can be (0..15).
+ * @retval The input port pin value.
+ */
+HAL_ACCESSOR GPIO_StateTypeDef GPIO_TypeDef::ReadPin(uint32_t pin) {
+    return ((REGS.INDR & pin) != 0U) ? GPIO_STATE_SET : GPIO_STATE_RESET;
+}
+
+/**
+ * @brief  Set or clear the selected data port bit.
+ * @note   This function uses GPIOx_BSHR and GPIOx_BCR registers to allow atomic read/modify
+ *         accesses. In this way, there is no risk of an IRQ occurring between
+ *         the read and the modify access.
+ * @param  pin specifies the port bit to be written.
+ *         This parameter can be one of GPIO_PIN_x where x can be (0..15).
+ * @param  state specifies the value to be written to the selected bit.
+ *         This parameter can be one of the GPIO_StateTypeDef enum values:
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::WritePin(uint32_t pin, GPIO_StateTypeDef state) {
+    if(state != GPIO_STATE_RESET)
+        REGS.BSHR = pin;
+    else
+        REGS.BCR = pin;
+}
+
+/**
+ * @brief  Set the selected data port bit.
+ * @note   This function uses GPIOx_BSHR register to allow atomic read/modify
+ *         accesses. In this way, there is no risk of an IRQ occurring between
+ *         the read and the modify access.
+ * @param  pin specifies the port bit to be written.
+ *         This parameter can be one of GPIO_PIN_x where x can be (0..15).
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::SetPin(uint32_t pin) {
+    REGS.BSHR = pin;
+}
+
+/**
+ * @brief  Clear the selected data port bit.
+ * @note   This function uses GPIOx_BCR register to allow atomic read/modify
+ *         accesses. In this way, there is no risk of an IRQ occurring between
+ *         the read and the modify access.
+ * @param  pin specifies the port bit to be written.
+ *         This parameter can be one of GPIO_PIN_x where x can be (0..15).
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::ResetPin(uint32_t pin) {
+    REGS.BCR = pin;
+}
+
+/**
+ * @brief  Toggle the specified GPIO pin.
+ * @param  pin specifies the pin to be toggled.
+ * @retval None.
+ */
+HAL_ACCESSOR void GPIO_TypeDef::TogglePin(uint32_t pin) {
+    uint32_t odr = REGS.OUTDR;
+    REGS.BSHR = ((odr & pin) << 16U) | (~odr & pin);
+}
+
+#endif /* __CH32V00x_HAL_GPIO_INLINE_H */
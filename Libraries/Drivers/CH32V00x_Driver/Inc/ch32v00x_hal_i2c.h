@@ -4,6 +4,10 @@
 
 #include "ch32v00x_hal.h"
 
+#ifndef I2C_BAUDRATE_TOLERANCE
+#define I2C_BAUDRATE_TOLERANCE                  (100000U)       /*!< Maximum baudrate error in ppm */
+#endif /* I2C_BAUDRATE_TOLERANCE */
+
 typedef enum {
     I2C_BAUDRATE_100KHz = 100000U,
     I2C_BAUDRATE_200KHz = 200000U,
@@ -48,6 +52,30 @@ private:
     __IO uint16_t RESERVED7;
 } I2C_RegsTypeDef;
 
+typedef struct {
+    uint16_t FREQ;
+    uint16_t CKCFGR;
+    uint32_t BaudRate;
+    uint32_t Error;
+} I2C_BaudRateCalcTypeDef;
+
+/**
+ * @brief  Compute at compile time the FREQ and CKCFGR values for an I2C baudrate.
+ * @param  hclk HCLK frequency (in Hz) the I2C is clocked from.
+ * @param  baudRate specifies the maximum SCL frequency.
+ * @note   CKCFGR is rounded up so the actual baudrate never exceeds baudRate.
+ * @retval FREQ and CKCFGR values, actual baudrate and error in ppm.
+ */
+constexpr I2C_BaudRateCalcTypeDef I2C_CalcBaudRate(uint32_t hclk, uint32_t baudRate) {
+    uint32_t ccr = (hclk + (baudRate << 1U) - 1U) / (baudRate << 1U);
+    return {
+        (uint16_t)((hclk / 1000000U) << I2C_CTLR2_FREQ_Pos),
+        (uint16_t)ccr,
+        hclk / (ccr << 1U),
+        HAL_GetErrorPpm(hclk / (ccr << 1U), baudRate)
+    };
+}
+
 class I2C_MasterTypeDef {
 private:
     I2C_RegsTypeDef REGS;
@@ -87,6 +115,8 @@ private:
     I2C_RegsTypeDef REGS;
 public:
     void SetBaudRate(I2C_BaudRateTypeDef baudrate);
+    template<uint32_t hclk, I2C_BaudRateTypeDef baudRate, uint32_t tolerance = I2C_BAUDRATE_TOLERANCE>
+    uint32_t SetBaudRate(void);
 private:
     I2C_ClockTypeDef(void) = delete;
     I2C_ClockTypeDef(const I2C_ClockTypeDef &) = delete;
@@ -116,4 +146,23 @@ private:
 
 #define I2C1            (*(I2C_TypeDef *)I2C1_BASE)
 
+/**
+ * @brief  Set baudrate for I2C clock signal with the values computed at compile time.
+ * @tparam hclk HCLK frequency (in Hz) the I2C is clocked from.
+ * @tparam baudRate specifies the baudRate to be set for I2C.
+ * @tparam tolerance maximum allowed baudrate error in ppm.
+ * @note   Compilation fails if the baudrate cannot be reached within the tolerance.
+ * @retval Actual baudrate value.
+ */
+template<uint32_t hclk, I2C_BaudRateTypeDef baudRate, uint32_t tolerance>
+uint32_t I2C_ClockTypeDef::SetBaudRate(void) {
+    constexpr I2C_BaudRateCalcTypeDef calc = I2C_CalcBaudRate(hclk, baudRate);
+    static_assert((hclk >= 2000000U) && (hclk <= 48000000U), "I2C requires HCLK between 2 MHz and 48 MHz");
+    static_assert((calc.CKCFGR >= 4U) && (calc.CKCFGR <= I2C_CKCFGR_CCR), "I2C baudrate out of range");
+    static_assert(calc.Error <= tolerance, "I2C baudrate error exceeds the tolerance");
+    REGS.CTLR2 = (REGS.CTLR2 & ~I2C_CTLR2_FREQ) | calc.FREQ;
+    REGS.CKCFGR = calc.CKCFGR;
+    return calc.BaudRate;
+}
+
 #endif /* __CH32V00x_HAL_I2C_H */
@@ -0,0 +1,96 @@
+
+#ifndef __CH32V00x_HAL_IRQSTATS_H
+#define __CH32V00x_HAL_IRQSTATS_H
+
+#include "ch32v00x_hal.h"
+
+#define HAL_IRQ_STATS_NONE                      (0x00U)
+#define HAL_IRQ_STATS_HISTOGRAM                 (0x01U)     /*!< Duration and latency histograms in RAM */
+#define HAL_IRQ_STATS_GPIO                      (0x02U)     /*!< Pin high while an instrumented handler runs */
+
+#ifndef HAL_IRQ_STATS
+#define HAL_IRQ_STATS                           HAL_IRQ_STATS_NONE
+#endif /* HAL_IRQ_STATS */
+
+#define HAL_IRQ_STATS_BUCKETS                   (8U)
+
+typedef enum {
+    HAL_IRQ_STATS_SYSTICK = 0U,
+    HAL_IRQ_STATS_EXTI,
+    HAL_IRQ_STATS_FLASH,
+    HAL_IRQ_STATS_WWDG,
+    HAL_IRQ_STATS_DMA,
+    HAL_IRQ_STATS_USART,
+    HAL_IRQ_STATS_COUNT
+} HAL_IRQStatsIdTypeDef;
+
+/**
+ * @brief Statistics of one handler, in SysTick ticks.
+ *        Bucket 0 counts 0 tick, bucket n counts [2^(n-1), 2^n) ticks,
+ *        the last bucket also counts everything above. When a bucket is full, all
+ *        the buckets and Count of the handler are halved: the histograms keep their
+ *        shape and Count then gives the calls in the same scale. Maximums saturate.
+ */
+typedef struct {
+    uint16_t Count;
+    uint16_t MaxDuration;
+    uint16_t MaxLatency;                        /*!< Only for handlers started at a known time (SysTick) */
+    uint8_t Duration[HAL_IRQ_STATS_BUCKETS];
+    uint8_t Latency[HAL_IRQ_STATS_BUCKETS];
+} HAL_IRQStatsTypeDef;
+
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+void HAL_IRQStatsRecord(HAL_IRQStatsIdTypeDef id, uint32_t duration);
+void HAL_IRQStatsLatency(HAL_IRQStatsIdTypeDef id, uint32_t latency);
+#endif
+const HAL_IRQStatsTypeDef *HAL_GetIRQStats(HAL_IRQStatsIdTypeDef id);
+void HAL_ResetIRQStats(void);
+
+#if (HAL_IRQ_STATS != HAL_IRQ_STATS_NONE)
+
+/**
+ * @brief Scope guard timestamping the entry and the exit of a handler.
+ */
+class HAL_IRQScopeTypeDef {
+public:
+    __attribute__((always_inline)) HAL_IRQScopeTypeDef(HAL_IRQStatsIdTypeDef id) : id(id) {
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_GPIO)
+        HAL_IRQ_STATS_GPIO_PORT.REGS.BSHR = HAL_IRQ_STATS_GPIO_PIN;
+#endif
+        entry = SysTick->CNT;
+    }
+    __attribute__((always_inline)) ~HAL_IRQScopeTypeDef(void) {
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+        HAL_IRQStatsRecord(id, SysTick->CNT - entry);
+#endif
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_GPIO)
+        HAL_IRQ_STATS_GPIO_PORT.REGS.BCR = HAL_IRQ_STATS_GPIO_PIN;
+#endif
+    }
+    __attribute__((always_inline)) void Latency(uint32_t due) {
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+        HAL_IRQStatsLatency(id, entry - due);
+#else
+        (void)due;
+#endif
+    }
+private:
+    HAL_IRQStatsIdTypeDef id;
+    uint32_t entry;
+};
+
+/**
+ * @brief Instrument the enclosing handler, place it first in the handler body.
+ *        HAL_IRQ_LATENCY gives the tick the interrupt was due at, when it is known.
+ */
+#define HAL_IRQ_SCOPE(id)                       HAL_IRQScopeTypeDef halIrqScope(id)
+#define HAL_IRQ_LATENCY(due)                    halIrqScope.Latency(due)
+
+#else
+
+#define HAL_IRQ_SCOPE(id)
+#define HAL_IRQ_LATENCY(due)
+
+#endif /* HAL_IRQ_STATS != HAL_IRQ_STATS_NONE */
+
+#endif /* __CH32V00x_HAL_IRQSTATS_H */
@@ -34,6 +34,6 @@ private:
     void operator=(const IWDG_TypeDef &) = delete;
 };
 
-#define IWDG            ((IWDG_TypeDef *)IWDG_BASE)
+#define IWDG            (*(IWDG_TypeDef *)IWDG_BASE)
 
 #endif /* __CH32V00x_HAL_IWDG_H */
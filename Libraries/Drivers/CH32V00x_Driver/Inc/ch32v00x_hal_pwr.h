@@ -54,7 +54,8 @@ public:
     void DisableClock(void);
     void SetPVD(PWR_PvdLevelTypeDef level);
     void SetAWU(PWR_AwuDivTypeDef div, uint8_t windowValue = 0x3FU);
-    void EnterStandbyMode(PWR_StanbyModeTypeDef mode);
+    void SetWakeupSource(uint32_t line, HAL_StateTypeDef state = ENABLE);
+    HAL_StatusTypeDef EnterStandbyMode(PWR_StanbyModeTypeDef mode);
     HAL_FlagStatusTypeDef GetPVD0(void);
     void DeInit(void);
 private:
@@ -40,6 +40,54 @@ typedef enum {
     RCC_OUTPUTCLK_PLL = 0x07
 } RCC_OutputSourceTypeDef;
 
+typedef struct {
+    uint32_t CTLR;
+    uint32_t CFGR0;
+    uint32_t ACTLR;
+    uint32_t HCLK;
+    uint16_t USART_BRR;
+    uint16_t I2C_FREQ;
+    uint16_t I2C_CKCFGR;
+} RCC_ProfileTypeDef;
+
+/**
+ * @brief  Compute at compile time a clock profile to be applied by RCC.SetProfile.
+ * @param  source specifies the system clock source of the profile.
+ * @param  div specifies the AHB clock prescaler of the profile.
+ * @param  pllSource specifies the PLL input clock when source is RCC_SYSCLKSRC_PLL.
+ * @param  usartBaudRate specifies the USART1 baudrate to be kept with this profile.
+ *         0 means USART1 is not retuned when the profile is applied.
+ * @param  i2cBaudRate specifies the I2C1 baudrate to be kept with this profile.
+ *         0 means I2C1 is not retuned when the profile is applied.
+ * @retval Clock profile.
+ */
+constexpr RCC_ProfileTypeDef RCC_Profile(RCC_SysClkSrcTypeDef source, RCC_SysClkDivTypeDef div = RCC_SYSCLK_DIV1,
+                                         RCC_PllSrcTypeDef pllSource = RCC_PLLSRC_HSI,
+                                         uint32_t usartBaudRate = 0U, uint32_t i2cBaudRate = 0U) {
+    uint32_t sysclk = (source == RCC_SYSCLKSRC_HSI) ? HSI_VALUE :
+                      (source == RCC_SYSCLKSRC_HSE) ? HSE_VALUE :
+                      (pllSource == RCC_PLLSRC_HSE) ? (HSE_VALUE * 2U) : (HSI_VALUE * 2U);
+    uint32_t hclk = (div < 8U) ? (sysclk / (div + 1U)) : (sysclk >> (div - 7U));
+    uint32_t ctlr = 0U;
+    if(source == RCC_SYSCLKSRC_PLL)
+        ctlr |= RCC_CTLR_PLLON;
+    if((source == RCC_SYSCLKSRC_HSE) || ((source == RCC_SYSCLKSRC_PLL) && (pllSource == RCC_PLLSRC_HSE)))
+        ctlr |= RCC_CTLR_HSEON;
+    return {
+        ctlr,
+        (uint32_t)(((uint32_t)source << RCC_CFGR0_SW_Pos) | ((uint32_t)div << RCC_CFGR0_HPRE_Pos) |
+                   ((pllSource == RCC_PLLSRC_HSE) ? RCC_CFGR0_PLLSRC : 0U)),
+        (hclk > HSI_VALUE) ? (1U << FLASH_ACTLR_LATENCY_Pos) : 0U,
+        hclk,
+        (uint16_t)(usartBaudRate ? ((hclk + (usartBaudRate / 2U)) / usartBaudRate) : 0U),
+        (uint16_t)(i2cBaudRate ? ((hclk / 1000000U) << I2C_CTLR2_FREQ_Pos) : 0U),
+        (uint16_t)(i2cBaudRate ? (hclk / (i2cBaudRate << 1U)) : 0U)
+    };
+}
+
+constexpr RCC_ProfileTypeDef RCC_PROFILE_RUN = RCC_Profile(RCC_SYSCLKSRC_PLL);
+constexpr RCC_ProfileTypeDef RCC_PROFILE_SLOW = RCC_Profile(RCC_SYSCLKSRC_HSI, RCC_SYSCLK_DIV4);
+
 typedef struct {
 public:
     __IO uint32_t CTLR;
@@ -150,6 +198,8 @@ public:
         RCC_OutClkTypeDef OutClk;
     };
 public:
+    HAL_StatusTypeDef SetProfile(const RCC_ProfileTypeDef &profile);
+    HAL_StatusTypeDef Resume(uint32_t ctlr, uint32_t cfgr0);
     void DeInit(void);
 private:
     RCC_TypeDef(void);
@@ -159,4 +209,6 @@ private:
 
 #define RCC             (*(RCC_TypeDef *)RCC_BASE)
 
+void CoreClockUpdate(void);
+
 #endif /* __CH32V00x_HAL_RCC_H */
@@ -4,6 +4,10 @@
 
 #include "ch32v00x_hal.h"
 
+#ifndef SPI_BAUDRATE_TOLERANCE
+#define SPI_BAUDRATE_TOLERANCE                  (500000U)       /*!< Maximum baudrate error in ppm */
+#endif /* SPI_BAUDRATE_TOLERANCE */
+
 typedef enum {
     HAL_SPI_STATE_RESET = 0x00U,
     HAL_SPI_STATE_READY = 0x01U,
@@ -68,6 +72,26 @@ private:
     __IO uint16_t RESERVED9;
 } SPI_RegsTypeDef;
 
+typedef struct {
+    uint32_t Div;
+    uint32_t BaudRate;
+    uint32_t Error;
+} SPI_BaudRateCalcTypeDef;
+
+/**
+ * @brief  Compute at compile time the smallest SPI prescaler not exceeding a baudrate.
+ * @param  hclk HCLK frequency (in Hz) the SPI is clocked from.
+ * @param  baudRate specifies the maximum SCK frequency.
+ * @note   Div is greater than SPI_BAUDRATE_DIV256 if the baudrate cannot be reached.
+ * @retval Prescaler value, actual baudrate and error in ppm.
+ */
+constexpr SPI_BaudRateCalcTypeDef SPI_CalcBaudRate(uint32_t hclk, uint32_t baudRate) {
+    uint32_t div = SPI_BAUDRATE_DIV2;
+    while((div <= SPI_BAUDRATE_DIV256) && ((hclk >> (div + 1U)) > baudRate))
+        div++;
+    return {div, hclk >> (div + 1U), HAL_GetErrorPpm(hclk >> (div + 1U), baudRate)};
+}
+
 class SPI_ModeTypeDef {
 private:
     SPI_RegsTypeDef REGS;
@@ -106,6 +130,8 @@ public:
     void SetPolarity(SPI_PolarityTypeDef polarity);
     void SetPhase(SPI_PhaseTypeDef phase);
     void SetBaudRate(SPI_BaudRateTypeDef baudRate);
+    template<uint32_t hclk, uint32_t baudRate, uint32_t tolerance = SPI_BAUDRATE_TOLERANCE>
+    uint32_t SetBaudRate(void);
 private:
     SPI_ClkTypeDef(void) = delete;
     SPI_ClkTypeDef(const SPI_ClkTypeDef &) = delete;
@@ -182,4 +208,28 @@ private:
 
 #define SPI1            (*(SPI_TypeDef *)SPI1_BASE)
 
+/**
+ * @brief  Set baudrate for SPI clock signal with the prescaler computed at compile time.
+ * @tparam hclk HCLK frequency (in Hz) the SPI is clocked from.
+ * @tparam baudRate specifies the maximum SCK frequency.
+ * @tparam tolerance maximum allowed baudrate error in ppm.
+ * @note   The selected prescaler is the smallest one that does not exceed baudRate.
+ *         Compilation fails if baudRate is lower than hclk / 256 or if the prescaler
+ *         cannot reach it within the tolerance. With power of 2 prescalers the error is
+ *         below 50%, which the default SPI_BAUDRATE_TOLERANCE accepts.
+ * @retval Actual baudrate value.
+ */
+template<uint32_t hclk, uint32_t baudRate, uint32_t tolerance>
+uint32_t SPI_ClkTypeDef::SetBaudRate(void) {
+    constexpr SPI_BaudRateCalcTypeDef calc = SPI_CalcBaudRate(hclk, baudRate);
+    static_assert(calc.Div <= SPI_BAUDRATE_DIV256, "SPI baudrate too low for this HCLK");
+    static_assert(calc.Error <= tolerance, "SPI baudrate error exceeds the tolerance");
+    SetBaudRate((SPI_BaudRateTypeDef)calc.Div);
+    return calc.BaudRate;
+}
+
+#if (HAL_INLINE_ACCESSORS != 0U)
+#include "ch32v00x_hal_spi_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #endif /* __CH32V00x_HAL_SPI_H */
@@ -0,0 +1,148 @@
+
+#ifndef __CH32V00x_HAL_SPI_INLINE_H
+#define __CH32V00x_HAL_SPI_INLINE_H
+
+/* SPI accessors, inlined in ch32v00x_hal_spi.h when HAL_INLINE_ACCESSORS is enabled */
+
+/**
+ * @brief  Set 8 bits mode data size when transmitting and receiving for SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_DataSizeTypeDef::Mode8Bit(void) {
+    REGS.CTLR1 &= ~SPI_CTLR1_DFF;
+}
+
+/**
+ * @brief  Set 16 bits mode data size when transmitting and receiving for SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_DataSizeTypeDef::Mode16Bit(void) {
+    REGS.CTLR1 |= SPI_CTLR1_DFF;
+}
+
+/**
+ * @brief  Check whether the current SPI configuration is 8-bit mode or not.
+ * @retval Boolean.
+ */
+HAL_ACCESSOR bool SPI_DataSizeTypeDef::IsMode8Bit(void) {
+    return (REGS.CTLR1 & SPI_CTLR1_DFF) == 0U;
+}
+
+/**
+ * @brief  Check whether the current SPI configuration is 16-bit mode or not.
+ * @retval Boolean.
+ */
+HAL_ACCESSOR bool SPI_DataSizeTypeDef::IsMode16Bit(void) {
+    return (REGS.CTLR1 & SPI_CTLR1_DFF) == SPI_CTLR1_DFF;
+}
+
+/**
+ * @brief  Set polarity for SPI clock signal.
+ * @param  polarity specifies the polarity (CLK idle state) to be set for SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_ClkTypeDef::SetPolarity(SPI_PolarityTypeDef polarity) {
+    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_CPOL) | (polarity << SPI_CTLR1_CPOL_Pos);
+}
+
+/**
+ * @brief  Set phase for SPI clock signal.
+ * @param  phase specifies the phase (sampling point) to be set for SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_ClkTypeDef::SetPhase(SPI_PhaseTypeDef phase) {
+    uint32_t polarity = (REGS.CTLR1 & SPI_CTLR1_CPOL) >> SPI_CTLR1_CPOL_Pos;
+    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_CPHA) | ((polarity ^ phase) << SPI_CTLR1_CPHA_Pos);
+}
+
+/**
+ * @brief  Set baudrate for SPI clock signal.
+ * @param  baudRate specifies the baudRate to be set for SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_ClkTypeDef::SetBaudRate(SPI_BaudRateTypeDef baudRate) {
+    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_BR) | (baudRate << SPI_CTLR1_BR_Pos);
+}
+
+/**
+ * @brief  Set MSB will be sent first.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_FirstBitTypeDef::MSBFirst(void) {
+    REGS.CTLR1 &= ~SPI_CTLR1_LSBFIRST;
+}
+
+/**
+ * @brief  Set LSB will be sent first.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_FirstBitTypeDef::LSBFirst(void) {
+    REGS.CTLR1 |= SPI_CTLR1_LSBFIRST;
+}
+
+/**
+ * @brief  Disabe hardware CRC checksum.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_CrcTypeDef::Disable(void) {
+    REGS.CTLR1 &= ~SPI_CTLR1_CRCEN;
+}
+
+/**
+ * @brief  Return state of CRC.
+ * @retval Boolean.
+ */
+HAL_ACCESSOR bool SPI_CrcTypeDef::IsEnable(void) {
+    return (REGS.CTLR1 & SPI_CTLR1_CRCEN) == SPI_CTLR1_CRCEN;
+}
+
+/**
+ * @brief  Enable the SPI peripheral clock.
+ * @note   This function will use RCC module to enable clock for SPI peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_TypeDef::EnableClock(void) {
+    if(this == &SPI1)
+        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_SPI1EN;
+}
+
+/**
+ * @brief  Disable the SPI peripheral clock.
+ * @note   This function will use RCC module to disable clock for SPI peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_TypeDef::DisableClock(void) {
+    if(this == &SPI1)
+        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_SPI1EN;
+}
+
+/**
+ * @brief  Enable SPI.
+ * @note   To be able to transmit and receive data, SPI must be enabled.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_TypeDef::Enable(void) {
+    REGS.CTLR1 |= SPI_CTLR1_SPE;
+}
+
+/**
+ * @brief  Disable SPI.
+ * @retval None.
+ */
+HAL_ACCESSOR void SPI_TypeDef::Disable(void) {
+    REGS.CTLR1 &= ~SPI_CTLR1_SPE;
+}
+
+/**
+ * @brief  Get current SPI status.
+ * @retval SPI status.
+ */
+HAL_ACCESSOR SPI_StatusTypeDef SPI_TypeDef::GetStatus(void) {
+    if(REGS.STATR & SPI_STATR_BSY)
+        return HAL_SPI_STATE_BUSY;
+    if(!(REGS.CTLR1 & SPI_CTLR1_SPE))
+        return HAL_SPI_STATE_RESET;
+    return HAL_SPI_STATE_READY;
+}
+
+#endif /* __CH32V00x_HAL_SPI_INLINE_H */
@@ -0,0 +1,187 @@
+
+#ifndef __CH32V00x_HAL_TIME_H
+#define __CH32V00x_HAL_TIME_H
+
+#include "ch32v00x.h"
+
+/**
+ * @brief  Positive digits of the non-adjacent form (NAF) of a constant.
+ * @param  c constant value.
+ * @retval Bit mask of the +1 digits.
+ */
+constexpr uint64_t HAL_NafPos(uint64_t c) {
+    return (c + (c >> 1U)) & ((c >> 1U) ^ (c + (c >> 1U)));
+}
+
+/**
+ * @brief  Negative digits of the non-adjacent form (NAF) of a constant.
+ * @param  c constant value.
+ * @retval Bit mask of the -1 digits.
+ */
+constexpr uint64_t HAL_NafNeg(uint64_t c) {
+    return (c >> 1U) & ((c >> 1U) ^ (c + (c >> 1U)));
+}
+
+constexpr uint32_t HAL_BitCount(uint64_t c) {
+    return (c != 0U) ? (uint32_t)(c & 1U) + HAL_BitCount(c >> 1U) : 0U;
+}
+
+constexpr uint32_t HAL_LowBit(uint64_t c) {
+    return ((c == 0U) || (c & 1U)) ? 0U : 1U + HAL_LowBit(c >> 1U);
+}
+
+constexpr uint32_t HAL_Gcd(uint32_t a, uint32_t b) {
+    return (b == 0U) ? a : HAL_Gcd(b, a % b);
+}
+
+/**
+ * @brief  Sum of shifted copies of x, one per set bit of pos (added) and neg (subtracted).
+ * @note   With base = 0 each term is x << bit, otherwise x >> (base - bit).
+ *         The expansion is done at compile time and produces straight shift/add code.
+ */
+template<uint64_t pos, uint64_t neg, uint32_t base, uint32_t bit = HAL_LowBit(pos | neg)>
+struct HAL_ShiftSum {
+    __STATIC_FORCEINLINE constexpr uint32_t Term(uint32_t x) {
+        return (base == 0U) ? ((bit < 32U) ? (x << (bit & 31U)) : 0U) :
+               ((bit >= base) ? x : ((base - bit) < 32U) ? (x >> ((base - bit) & 31U)) : 0U);
+    }
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t x) {
+        return ((pos >> bit) & 1U ? Term(x) : 0U - Term(x)) +
+               HAL_ShiftSum<pos & ~(1ULL << bit), neg & ~(1ULL << bit), base>::Calc(x);
+    }
+};
+
+template<uint32_t base, uint32_t bit>
+struct HAL_ShiftSum<0ULL, 0ULL, base, bit> {
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t x) {
+        return (void)x, 0U;
+    }
+};
+
+/**
+ * @brief  Multiply by a constant (modulo 2^32) with shift/add/sub only.
+ */
+template<uint32_t c>
+__STATIC_FORCEINLINE constexpr uint32_t HAL_MulConst(uint32_t x) {
+    return HAL_ShiftSum<HAL_NafPos(c), HAL_NafNeg(c), 0U>::Calc(x);
+}
+
+/**
+ * @brief  Smallest shift s so that (x * ceil(2^s / d)) >> s equals x / d for every x <= max
+ *         without overflowing 32 bits.
+ * @retval Shift value, or 64 if there is none.
+ */
+constexpr uint32_t HAL_DivShift(uint32_t d, uint32_t max, uint32_t s = 0U) {
+    return (s >= 64U) ? 64U :
+           ((((((1ULL << s) + d - 1U) / d) * d - (1ULL << s)) * max < (1ULL << s)) &&
+            ((((1ULL << s) + d - 1U) / d) * max <= 0xFFFFFFFFULL)) ? s : HAL_DivShift(d, max, s + 1U);
+}
+
+/**
+ * @brief  Period of the binary expansion of 1/d (multiplicative order of 2 modulo d).
+ * @retval Period value, or 0 if it is longer than 16 bits.
+ */
+constexpr uint32_t HAL_DivPeriod(uint32_t d, uint32_t p = 1U) {
+    return (p > 16U) ? 0U : ((((1UL << p) - 1U) % d) == 0U) ? p : HAL_DivPeriod(d, p + 1U);
+}
+
+constexpr uint32_t HAL_DivSteps(uint32_t s) {
+    return (s >= 32U) ? 0U : 1U + HAL_DivSteps(s << 1U);
+}
+
+template<uint32_t s, bool done = (s >= 32U)>
+struct HAL_DivDoubling {
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t q) {
+        return HAL_DivDoubling<(s << 1U)>::Calc(q + (q >> s));
+    }
+};
+
+template<uint32_t s>
+struct HAL_DivDoubling<s, true> {
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t q) {
+        return q;
+    }
+};
+
+template<uint32_t d, uint32_t max, bool direct>
+struct HAL_DivConstImpl;
+
+/**
+ * @brief  Unsigned division x / d by a constant with shift/add/sub only, exact for every x <= max.
+ * @note   d must be odd, powers of two are handled by HAL_Scale.
+ */
+template<uint32_t d, uint32_t max = 0xFFFFFFFFU>
+using HAL_DivConst = HAL_DivConstImpl<d, max, (HAL_DivShift(d, max) < 64U)>;
+
+/* Small range: single multiply by the rounded-up reciprocal */
+template<uint32_t d, uint32_t max>
+struct HAL_DivConstImpl<d, max, true> {
+    static constexpr uint32_t Shift = HAL_DivShift(d, max);
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t x) {
+        return HAL_MulConst<(uint32_t)(((1ULL << Shift) + d - 1U) / d)>(x) >> (Shift & 31U);
+    }
+};
+
+/* Full range: estimate the quotient, then correct it from the remainder */
+template<uint32_t d, uint32_t max>
+struct HAL_DivConstImpl<d, max, false> {
+    static constexpr uint32_t Period = HAL_DivPeriod(d);
+    static constexpr uint32_t Unit = (Period != 0U) ? (uint32_t)(((1UL << Period) - 1U) / d) : 0U;
+    static constexpr uint64_t Recip = (1ULL << 32U) / d;
+    static constexpr bool Periodic = (Period != 0U) &&
+        ((HAL_BitCount(Unit) + HAL_DivSteps(Period)) < HAL_BitCount(HAL_NafPos(Recip) | HAL_NafNeg(Recip)));
+    /* Worst case distance between the estimate and the exact quotient */
+    static constexpr uint32_t Bound = Periodic ? (2U * (HAL_BitCount(Unit) + HAL_DivSteps(Period)) + 2U) :
+                                                 (HAL_BitCount(HAL_NafPos(Recip) | HAL_NafNeg(Recip)) + 2U);
+    static_assert((d & 1U) && (d > 1U), "Divisor must be odd");
+    __STATIC_FORCEINLINE constexpr uint32_t Estimate(uint32_t x) {
+        return Periodic ? HAL_DivDoubling<Period>::Calc(HAL_ShiftSum<Unit, 0ULL, Period>::Calc(x)) :
+                          HAL_ShiftSum<HAL_NafPos(Recip), HAL_NafNeg(Recip), 32U>::Calc(x);
+    }
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t x) {
+        return Estimate(x) - Bound + HAL_DivConst<d, (2U * Bound + 1U) * d - 1U>::Calc(x - HAL_MulConst<d>(Estimate(x)) + Bound * d);
+    }
+};
+
+/**
+ * @brief  Compute (x * num / den) rounded down, modulo 2^32, with shift/add/sub only.
+ * @note   num / den is reduced at compile time, the reduced num * den must fit in 32 bits.
+ */
+template<uint32_t num, uint32_t den>
+struct HAL_Scale {
+    static constexpr uint32_t N = num / HAL_Gcd(num, den);
+    static constexpr uint32_t D = den / HAL_Gcd(num, den);
+    static constexpr uint32_t K = HAL_LowBit(D);
+    static_assert(((uint64_t)N * D) <= 0xFFFFFFFFULL, "Scale ratio is not supported");
+    __STATIC_FORCEINLINE constexpr uint32_t Calc(uint32_t x) {
+        return (D == 1U) ? HAL_MulConst<N>(x) :
+               (N == 1U) ? HAL_DivConst<(D >> K)>::Calc(x >> K) :
+               Remainder(x, HAL_DivConst<(D >> K)>::Calc(x >> K));
+    }
+private:
+    __STATIC_FORCEINLINE constexpr uint32_t Remainder(uint32_t x, uint32_t q) {
+        return HAL_MulConst<N>(q) + HAL_DivConst<(D >> K), (((D - 1U) * N) >> K)>::Calc(HAL_MulConst<N>(x - HAL_MulConst<D>(q)) >> K);
+    }
+};
+
+/**
+ * @brief  SysTick (HCLK/8) time unit conversions for a HCLK known at compile time.
+ * @note   Every conversion compiles to a short sequence of shift/add instructions.
+ */
+template<uint32_t hclk>
+struct HAL_TickConvTypeDef {
+    __STATIC_FORCEINLINE constexpr uint32_t TicksToUs(uint32_t ticks) {
+        return HAL_Scale<8000000U, hclk>::Calc(ticks);
+    }
+    __STATIC_FORCEINLINE constexpr uint32_t TicksToMs(uint32_t ticks) {
+        return HAL_Scale<8000U, hclk>::Calc(ticks);
+    }
+    __STATIC_FORCEINLINE constexpr uint32_t UsToTicks(uint32_t time) {
+        return HAL_Scale<hclk, 8000000U>::Calc(time);
+    }
+    __STATIC_FORCEINLINE constexpr uint32_t MsToTicks(uint32_t time) {
+        return HAL_Scale<hclk, 8000U>::Calc(time);
+    }
+};
+
+#endif /* __CH32V00x_HAL_TIME_H */
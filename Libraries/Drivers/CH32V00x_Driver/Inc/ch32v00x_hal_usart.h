@@ -4,6 +4,10 @@
 
 #include "ch32v00x_hal.h"
 
+#ifndef USART_BAUDRATE_TOLERANCE
+#define USART_BAUDRATE_TOLERANCE                (20000U)        /*!< Maximum baudrate error in ppm */
+#endif /* USART_BAUDRATE_TOLERANCE */
+
 typedef struct {
 public:
     __IO uint16_t STATR;
@@ -35,6 +39,23 @@ private:
     __IO uint16_t RESERVED6;
 } USART_RegsTypeDef;
 
+typedef struct {
+    uint16_t BRR;
+    uint32_t BaudRate;
+    uint32_t Error;
+} USART_BaudrateCalcTypeDef;
+
+/**
+ * @brief  Compute at compile time the BRR value for a baudrate.
+ * @param  hclk HCLK frequency (in Hz) the USART is clocked from.
+ * @param  baudRate specifies the target baudrate.
+ * @retval BRR value, actual baudrate and error in ppm.
+ */
+constexpr USART_BaudrateCalcTypeDef USART_CalcBaudrate(uint32_t hclk, uint32_t baudRate) {
+    uint32_t brr = (hclk + (baudRate / 2U)) / baudRate;
+    return {(uint16_t)brr, hclk / brr, HAL_GetErrorPpm(hclk / brr, baudRate)};
+}
+
 class USART_RxModeTypeDef {
 private:
     USART_RegsTypeDef REGS;
@@ -64,6 +85,8 @@ private:
     USART_RegsTypeDef REGS;
 public:
     uint32_t SetValue(uint32_t baudRate);
+    template<uint32_t hclk, uint32_t baudRate, uint32_t tolerance = USART_BAUDRATE_TOLERANCE>
+    uint32_t SetValue(void);
     uint32_t GetValue(void);
 private:
     USART_BaudrateTypeDef(void) = delete;
@@ -111,6 +134,8 @@ public:
 public:
     void EnableClock(void);
     void DisableClock(void);
+    void Enable(void);
+    void Disable(void);
     HAL_StatusTypeDef Transmit(uint8_t *txData, uint16_t txLength, uint32_t timeout = 0xFFFFFFFFUL);
     HAL_StatusTypeDef Transmit(uint16_t *txData, uint16_t txLength, uint32_t timeout = 0xFFFFFFFFUL);
     HAL_StatusTypeDef Transmit(uint16_t txData, uint32_t timeout = 0xFFFFFFFFUL);
@@ -123,4 +148,25 @@ private:
 
 #define USART1          (*(USART_TypeDef *)USART1_BASE)
 
+/**
+ * @brief  Set baudrate for USART with the BRR value computed at compile time.
+ * @tparam hclk HCLK frequency (in Hz) the USART is clocked from.
+ * @tparam baudRate specifies the baudRate used for USART.
+ * @tparam tolerance maximum allowed baudrate error in ppm.
+ * @note   Compilation fails if the baudrate cannot be reached within the tolerance.
+ * @retval Actual baudrate value.
+ */
+template<uint32_t hclk, uint32_t baudRate, uint32_t tolerance>
+uint32_t USART_BaudrateTypeDef::SetValue(void) {
+    constexpr USART_BaudrateCalcTypeDef calc = USART_CalcBaudrate(hclk, baudRate);
+    static_assert((((hclk + (baudRate / 2U)) / baudRate) >= 16U) && (((hclk + (baudRate / 2U)) / baudRate) <= 0xFFFFU), "USART baudrate out of range");
+    static_assert(calc.Error <= tolerance, "USART baudrate error exceeds the tolerance");
+    REGS.BRR = calc.BRR;
+    return calc.BaudRate;
+}
+
+#if (HAL_INLINE_ACCESSORS != 0U)
+#include "ch32v00x_hal_usart_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #endif /* __CH32C00x_HAL_USART_H */
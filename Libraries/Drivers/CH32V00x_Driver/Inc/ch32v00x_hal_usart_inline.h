@@ -0,0 +1,132 @@
+
+#ifndef __CH32V00x_HAL_USART_INLINE_H
+#define __CH32V00x_HAL_USART_INLINE_H
+
+/* USART accessors, inlined in ch32v00x_hal_usart.h when HAL_INLINE_ACCESSORS is enabled */
+
+/**
+ * @brief  Enable USART Rx mode.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_RxModeTypeDef::Enable(void) {
+    REGS.CTLR1 |= USART_CTLR1_RE;
+}
+
+/**
+ * @brief  Disable USART Rx mode.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_RxModeTypeDef::Disable(void) {
+    REGS.CTLR1 &= ~USART_CTLR1_RE;
+}
+
+/**
+ * @brief  Enable USART Tx mode.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TxModeTypeDef::Enable(void) {
+    REGS.CTLR1 |= USART_CTLR1_TE;
+}
+
+/**
+ * @brief  Disable USART Tx mode.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TxModeTypeDef::Disable(void) {
+    REGS.CTLR1 &= ~USART_CTLR1_TE;
+}
+
+/**
+ * @brief  Set word length to 8-bits data for USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_WordLengthTypeDef::Mode8Bit(void) {
+    REGS.CTLR1 &= ~USART_CTLR1_M;
+}
+
+/**
+ * @brief  Set word length to 9-bits data for USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_WordLengthTypeDef::Mode9Bit(void) {
+    REGS.CTLR1 |= USART_CTLR1_M;
+}
+
+/**
+ * @brief  Check whether the current USART configuration is 8-bit mode or not.
+ * @retval Boolean.
+ */
+HAL_ACCESSOR bool USART_WordLengthTypeDef::IsMode8Bit(void) {
+    return (REGS.CTLR1 & USART_CTLR1_M) == 0U;
+}
+
+/**
+ * @brief  Check whether the current USART configuration is 9-bit mode or not.
+ * @retval Boolean.
+ */
+HAL_ACCESSOR bool USART_WordLengthTypeDef::IsMode9Bit(void) {
+    return (REGS.CTLR1 & USART_CTLR1_M) == USART_CTLR1_M;
+}
+
+/**
+ * @brief  Disable parity for USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_ParityTypeDef::Disable(void) {
+    REGS.CTLR1 &= ~(USART_CTLR1_PCE | USART_CTLR1_PS);
+}
+
+/**
+ * @brief  Set parity to even mode for USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_ParityTypeDef::Even(void) {
+    REGS.CTLR1 = (REGS.CTLR1 & ~USART_CTLR1_PS) | USART_CTLR1_PCE;
+}
+
+/**
+ * @brief  Set parity to odd mode for USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_ParityTypeDef::Odd(void) {
+    REGS.CTLR1 |= USART_CTLR1_PCE | USART_CTLR1_PS;
+}
+
+/**
+ * @brief  Enable the USART peripheral clock.
+ * @note   This function will use RCC module to enable clock for USART peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TypeDef::EnableClock(void) {
+    if(this == &USART1)
+        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_USART1EN;
+}
+
+/**
+ * @brief  Disable the USART peripheral clock.
+ * @note   This function will use RCC module to disable clock for USART peripheral.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TypeDef::DisableClock(void) {
+    if(this == &USART1)
+        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_USART1EN;
+}
+
+/**
+ * @brief  Enable USART.
+ * @note   To be able to transmit and receive data, USART must be enabled.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TypeDef::Enable(void) {
+    REGS.CTLR1 |= USART_CTLR1_UE;
+}
+
+/**
+ * @brief  Disable USART.
+ * @retval None.
+ */
+HAL_ACCESSOR void USART_TypeDef::Disable(void) {
+    REGS.CTLR1 &= ~USART_CTLR1_UE;
+}
+
+#endif /* __CH32V00x_HAL_USART_INLINE_H */
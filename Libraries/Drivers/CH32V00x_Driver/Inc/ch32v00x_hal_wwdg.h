@@ -0,0 +1,87 @@
+
+#ifndef __CH32V00x_HAL_WWDG_H
+#define __CH32V00x_HAL_WWDG_H
+
+#include "ch32v00x_hal.h"
+
+typedef void (*WWDG_CallbackTypeDef)(void);
+
+typedef struct {
+    uint16_t CFGR;
+    uint8_t Counter;
+    uint32_t Timeout;
+} WWDG_ConfigTypeDef;
+
+/**
+ * @brief  Compute the prescaler, counter and window values for a WWDG timeout.
+ * @param  hclk HCLK frequency (in Hz) the WWDG is clocked from.
+ * @param  timeoutUs time (in us) after the last refresh before the WWDG resets the MCU.
+ * @param  windowUs time (in us) after the last refresh before which a new refresh also
+ *         resets the MCU. 0 disables the window.
+ * @note   The smallest prescaler able to reach the timeout is selected for the best resolution.
+ *         The early wakeup interrupt occurs one WWDG clock period before the timeout.
+ * @retval CFGR and counter values, actual timeout (in us) or 0 if the values cannot be reached.
+ */
+constexpr WWDG_ConfigTypeDef WWDG_Config(uint32_t hclk, uint32_t timeoutUs, uint32_t windowUs = 0U) {
+    for(uint32_t div = 0U; div < 4U; div++) {
+        uint32_t clk = hclk >> (12U + div);
+        if((clk == 0U) || (timeoutUs > ((64U * 1000000U) / clk)))
+            continue;
+        uint32_t count = ((timeoutUs * clk) + 999999U) / 1000000U;
+        uint32_t window = ((windowUs * clk) + 999999U) / 1000000U;
+        if((count == 0U) || (windowUs > timeoutUs) || (window >= count))
+            return {0U, 0U, 0U};
+        return {
+            (uint16_t)((div << WWDG_CFGR_WDGTB_Pos) | (windowUs ? (0x3FU + count - window) : WWDG_CFGR_W)),
+            (uint8_t)(0x3FU + count),
+            (count * 1000000U) / clk
+        };
+    }
+    return {0U, 0U, 0U};
+}
+
+class WWDG_TypeDef {
+public:
+    struct {
+    public:
+        __IO uint32_t CTLR;
+        __IO uint32_t CFGR;
+        __IO uint32_t STATR;
+    } REGS;
+public:
+    void EnableClock(void);
+    void DisableClock(void);
+    HAL_StatusTypeDef Init(const WWDG_ConfigTypeDef &config, WWDG_CallbackTypeDef callback = NULL_PTR);
+    template<uint32_t hclk, uint32_t timeoutUs, uint32_t windowUs = 0U>
+    uint32_t Init(WWDG_CallbackTypeDef callback = NULL_PTR);
+    void Start(void);
+    void Reset(void);
+    void DeInit(void);
+private:
+    WWDG_TypeDef(void) = delete;
+    WWDG_TypeDef(const WWDG_TypeDef &) = delete;
+    void operator=(const WWDG_TypeDef &) = delete;
+
+    friend void WWDG_IRQHandler(void);
+};
+
+#define WWDG            (*(WWDG_TypeDef *)WWDG_BASE)
+
+/**
+ * @brief  Configure the WWDG with values computed at compile time.
+ * @tparam hclk HCLK frequency (in Hz) the WWDG is clocked from.
+ * @tparam timeoutUs time (in us) after the last refresh before the WWDG resets the MCU.
+ * @tparam windowUs time (in us) after the last refresh before which a refresh is not allowed.
+ * @param  callback function called from the early wakeup interrupt, just before the reset.
+ * @note   Compilation fails if the timeout or the window cannot be reached.
+ * @retval Actual timeout value (in us).
+ */
+template<uint32_t hclk, uint32_t timeoutUs, uint32_t windowUs>
+uint32_t WWDG_TypeDef::Init(WWDG_CallbackTypeDef callback) {
+    constexpr WWDG_ConfigTypeDef config = WWDG_Config(hclk, timeoutUs, windowUs);
+    static_assert(config.Timeout != 0U, "WWDG timeout or window out of range");
+    Init(config, callback);
+    return config.Timeout;
+}
+
+#endif /* __CH32V00x_HAL_WWDG_H */
@@ -1,20 +1,151 @@
 
 #include "ch32v00x_hal.h"
 
-#define __HAL_GetTickInterval()                 ((RCC.HCLK.GetFreq() / 8000U) * TickIntervalMs)
+#ifndef HAL_TICK_HCLK_LIST
+#define HAL_TICK_HCLK_LIST                      48000000U, 24000000U, 8000000U, 6000000U
+#endif /* HAL_TICK_HCLK_LIST */
 
+#ifndef HAL_TICK_IRQ_PRIORITY
+#define HAL_TICK_IRQ_PRIORITY                   HAL_IRQ_PRIORITY_LOW
+#endif /* HAL_TICK_IRQ_PRIORITY */
+
+typedef struct {
+    uint32_t HCLK;
+    uint32_t (*TicksToUs)(uint32_t ticks);
+    uint32_t (*TicksToMs)(uint32_t ticks);
+    uint32_t (*UsToTicks)(uint32_t time);
+    uint32_t (*MsToTicks)(uint32_t time);
+} HAL_TickProfileTypeDef;
+
+static HAL_IRQHandlerTypeDef TickHook = NULL_PTR;
 static uint32_t TickIntervalMs = 1;
+static uint32_t TickInterval = 0U;
+static uint32_t TicksPerMs = 1U;
+static HAL_TickClkTypeDef TickClock = HAL_TICKCLK_HCLK_DIV8;
+
+/**
+ * @brief  Conversions for a HCLK value which has no compile-time profile.
+ * @note   These functions use division and are only used as a fallback.
+ */
+static uint32_t HAL_TicksToUsDefault(uint32_t ticks) {
+    return (ticks / TicksPerMs) * 1000U + ((ticks % TicksPerMs) * 1000U) / TicksPerMs;
+}
+
+static uint32_t HAL_TicksToMsDefault(uint32_t ticks) {
+    return ticks / TicksPerMs;
+}
+
+static uint32_t HAL_UsToTicksDefault(uint32_t time) {
+    return (time / 1000U) * TicksPerMs + ((time % 1000U) * TicksPerMs) / 1000U;
+}
+
+static uint32_t HAL_MsToTicksDefault(uint32_t time) {
+    return time * TicksPerMs;
+}
+
+static const HAL_TickProfileTypeDef HAL_TickProfileDefault = {
+    0U, HAL_TicksToUsDefault, HAL_TicksToMsDefault, HAL_UsToTicksDefault, HAL_MsToTicksDefault
+};
+
+static const HAL_TickProfileTypeDef *TickProfile = &HAL_TickProfileDefault;
+
+template<uint32_t hclk>
+static uint32_t HAL_TicksToUs(uint32_t ticks) {
+    return HAL_TickConvTypeDef<hclk>::TicksToUs(ticks);
+}
+
+template<uint32_t hclk>
+static uint32_t HAL_TicksToMs(uint32_t ticks) {
+    return HAL_TickConvTypeDef<hclk>::TicksToMs(ticks);
+}
+
+template<uint32_t hclk>
+static uint32_t HAL_UsToTicks(uint32_t time) {
+    return HAL_TickConvTypeDef<hclk>::UsToTicks(time);
+}
+
+template<uint32_t hclk>
+static uint32_t HAL_MsToTicks(uint32_t time) {
+    return HAL_TickConvTypeDef<hclk>::MsToTicks(time);
+}
+
+/**
+ * @brief  Compare the conversions of a profile with the exact arithmetic at compile time.
+ * @note   The checked values are spread over the whole 32-bit range.
+ * @retval true if all the checked values match.
+ */
+template<uint32_t hclk>
+static constexpr bool HAL_TickProfileCheck(uint64_t x) {
+    return (HAL_TickConvTypeDef<hclk>::TicksToUs((uint32_t)x) == (uint32_t)((x * 8000000U) / hclk)) &&
+           (HAL_TickConvTypeDef<hclk>::TicksToMs((uint32_t)x) == (uint32_t)((x * 8000U) / hclk)) &&
+           (HAL_TickConvTypeDef<hclk>::UsToTicks((uint32_t)x) == (uint32_t)((x * hclk) / 8000000U)) &&
+           (HAL_TickConvTypeDef<hclk>::MsToTicks((uint32_t)x) == (uint32_t)((x * hclk) / 8000U));
+}
+
+template<uint32_t hclk>
+static constexpr bool HAL_TickProfileCheck(void) {
+    for(uint64_t x = 0U; x <= 0xFFFFFFFFULL; x += (x >> 3U) + 1U) {
+        if(HAL_TickProfileCheck<hclk>(x) == false)
+            return false;
+    }
+    return HAL_TickProfileCheck<hclk>(0xFFFFFFFFULL);
+}
+
+template<uint32_t... hclk>
+static constexpr bool HAL_TickProfileCheckAll(void) {
+    const bool checks[] = {HAL_TickProfileCheck<hclk>()...};
+    for(uint32_t i = 0U; i < LENGTH(checks); i++) {
+        if(checks[i] == false)
+            return false;
+    }
+    return true;
+}
+
+static_assert(HAL_TickProfileCheckAll<HAL_TICK_HCLK_LIST>(), "Tick conversions do not match the exact arithmetic");
+
+template<uint32_t... hclk>
+static const HAL_TickProfileTypeDef *HAL_GetTickProfile(uint32_t freq) {
+    static const HAL_TickProfileTypeDef profiles[] = {
+        {hclk, HAL_TicksToUs<hclk>, HAL_TicksToMs<hclk>, HAL_UsToTicks<hclk>, HAL_MsToTicks<hclk>}...
+    };
+    for(uint32_t i = 0U; i < LENGTH(profiles); i++) {
+        if(profiles[i].HCLK == freq)
+            return &profiles[i];
+    }
+    return &HAL_TickProfileDefault;
+}
+
+/**
+ * @brief  Select the time conversions matching the HCLK frequency.
+ * @param  hclk new HCLK frequency (in Hz).
+ * @note   This function is called automatically each time the HCLK frequency changes.
+ *         The HCLK values listed in HAL_TICK_HCLK_LIST use shift/add conversions,
+ *         others fall back to division. So does SysTick clocked from HCLK.
+ * @retval None.
+ */
+void HAL_TickProfileUpdate(uint32_t hclk) {
+    if(TickClock == HAL_TICKCLK_HCLK)
+        hclk <<= 3U;
+    TicksPerMs = hclk / 8000U;
+    TickProfile = HAL_GetTickProfile<HAL_TICK_HCLK_LIST>(hclk);
+    TickInterval = TickProfile->MsToTicks(TickIntervalMs);
+}
 
 /**
  * @brief  Initializes the HAL library.
  * @note   This function will also initialize the systick with HCLK/8 and enable interrupts.
+ * @note   The HCLK frequency is read back from RCC, so a clock already set up by
+ *         SystemInit before main is taken into account.
  * @retval None.
  */
 void HAL_TypeDef::Init(void) {
     SysTick->CTLR = STK_CTLR_STE | STK_CTLR_STIE;
+    TickClock = HAL_TICKCLK_HCLK_DIV8;
     TickIntervalMs = 1U;
+    CoreClockUpdate();
+    HAL_TickProfileUpdate(RCC.HCLK.GetFreq());
 
-    NVIC_SetPriority(SysTicK_IRQn, 0U);
+    NVIC_SetPriority(SysTicK_IRQn, HAL_TICK_IRQ_PRIORITY);
     NVIC_DisableIRQ(SysTicK_IRQn);
 }
 
@@ -23,7 +154,7 @@ void HAL_TypeDef::Init(void) {
  * @retval Tick value in microseconds.
  */
 uint32_t HAL_TypeDef::GetTickUs(void) {
-    return SysTick->CNT / (RCC.HCLK.GetFreq() / 8000000U);
+    return TickProfile->TicksToUs(SysTick->CNT);
 }
 
 /**
@@ -31,7 +162,7 @@ uint32_t HAL_TypeDef::GetTickUs(void) {
  * @retval Tick value in milliseconds.
  */
 uint32_t HAL_TypeDef::GetTickMs(void) {
-    return SysTick->CNT / (RCC.HCLK.GetFreq() / 8000U);
+    return TickProfile->TicksToMs(SysTick->CNT);
 }
 
 /**
@@ -41,7 +172,7 @@ uint32_t HAL_TypeDef::GetTickMs(void) {
  */
 void HAL_TypeDef::DelayUs(uint32_t time) {
     uint32_t tickstart = SysTick->CNT;
-    time *= RCC.HCLK.GetFreq() / 8000000U;
+    time = TickProfile->UsToTicks(time);
     while((uint32_t)(SysTick->CNT - tickstart) < time);
 }
 
@@ -52,18 +183,102 @@ void HAL_TypeDef::DelayUs(uint32_t time) {
  */
 void HAL_TypeDef::DelayMs(uint32_t time) {
     uint32_t tickstart = SysTick->CNT;
-    time *= RCC.HCLK.GetFreq() / 8000U;
+    time = TickProfile->MsToTicks(time);
     while((uint32_t)(SysTick->CNT - tickstart) < time);
 }
 
+/**
+ * @brief  Put the core in sleep mode until an interrupt or a timeout.
+ * @param  ticks timeout in systick ticks, 0 to wait for an interrupt only.
+ * @note   Call with interrupts masked after checking there is nothing to do: a pending
+ *         enabled interrupt still wakes the core up and is taken once the caller unmasks
+ *         interrupts, so no wake-up can be lost between the check and the sleep.
+ * @note   The timeout uses the systick compare when its interrupt is disabled, no tick
+ *         interrupt is taken. With EnabelTickIRQ, the periodic tick bounds the sleep.
+ * @retval None.
+ */
+void HAL_TypeDef::Sleep(uint32_t ticks) {
+    bool timeout = (ticks != 0U) && (NVIC_GetStatusIRQ(SysTicK_IRQn) == RESET);
+    if(timeout) {
+        uint32_t cmp = SysTick->CNT + ticks;
+        SysTick->CMP = cmp;
+        SysTick->SR = 0x00U;
+        NVIC_ClearPendingIRQ(SysTicK_IRQn);
+        if((int32_t)(SysTick->CNT - cmp) >= 0)
+            return;
+        NVIC_EnableIRQ(SysTicK_IRQn);
+    }
+    __WFI();
+    if(timeout) {
+        NVIC_DisableIRQ(SysTicK_IRQn);
+        SysTick->SR = 0x00U;
+        NVIC_ClearPendingIRQ(SysTicK_IRQn);
+    }
+}
+
+/**
+ * @brief  Convert systick ticks to microseconds.
+ * @param  ticks number of systick ticks.
+ * @retval Time in microseconds.
+ */
+uint32_t HAL_TypeDef::TicksToUs(uint32_t ticks) {
+    return TickProfile->TicksToUs(ticks);
+}
+
+/**
+ * @brief  Convert systick ticks to milliseconds.
+ * @param  ticks number of systick ticks.
+ * @retval Time in milliseconds.
+ */
+uint32_t HAL_TypeDef::TicksToMs(uint32_t ticks) {
+    return TickProfile->TicksToMs(ticks);
+}
+
+/**
+ * @brief  Convert microseconds to systick ticks.
+ * @param  time time in microseconds.
+ * @retval Number of systick ticks.
+ */
+uint32_t HAL_TypeDef::UsToTicks(uint32_t time) {
+    return TickProfile->UsToTicks(time);
+}
+
+/**
+ * @brief  Convert milliseconds to systick ticks.
+ * @param  time time in milliseconds.
+ * @retval Number of systick ticks.
+ */
+uint32_t HAL_TypeDef::MsToTicks(uint32_t time) {
+    return TickProfile->MsToTicks(time);
+}
+
 /**
  * @brief  Interrupt handler for SysTick.
  * @retval None.
  */
-__INTERRUPT void SysTick_Handler(void) {
+__RAMFUNC __INTERRUPT void SysTick_Handler(void) {
+    HAL_IRQ_SCOPE(HAL_IRQ_STATS_SYSTICK);
+    HAL_IRQ_LATENCY(SysTick->CMP);
     uint32_t tick = SysTick->CNT;
     SysTick->SR = 0x00U;
-    SysTick->CMP = tick + __HAL_GetTickInterval();
+    SysTick->CMP = tick + TickInterval;
+    if(TickHook != NULL_PTR)
+        TickHook();
+}
+
+/**
+ * @brief  Register the driver function called from SysTick_Handler on every tick interrupt.
+ * @param  hook function to be called, NULL_PTR removes the hook.
+ * @note   The drivers register their hook only when they need the tick, so that
+ *         SysTick_Handler does not pull them into every image. This function is internal
+ *         to the HAL drivers and is not declared in ch32v00x_hal.h.
+ * @retval HAL status, HAL_ERROR if another hook is already registered.
+ */
+HAL_StatusTypeDef HAL_SetTickHook(HAL_IRQHandlerTypeDef hook) {
+    if((hook != NULL_PTR) && (TickHook != NULL_PTR) && (TickHook != hook))
+        return HAL_ERROR;
+    TickHook = hook;
+    return HAL_OK;
 }
 
 /**
@@ -76,7 +291,8 @@ void HAL_TypeDef::EnabelTickIRQ(uint32_t interval) {
     if(interval == 0U)
         interval = 1U;
     TickIntervalMs = interval;
-    SysTick->CMP = SysTick->CNT + __HAL_GetTickInterval();
+    TickInterval = TickProfile->MsToTicks(interval);
+    SysTick->CMP = SysTick->CNT + TickInterval;
     NVIC_EnableIRQ(SysTicK_IRQn);
 }
 
@@ -87,3 +303,58 @@ void HAL_TypeDef::EnabelTickIRQ(uint32_t interval) {
 void HAL_TypeDef::DisableTickIRQ(void) {
     NVIC_DisableIRQ(SysTicK_IRQn);
 }
+
+/**
+ * @brief  Select the SysTick clock used as HAL time base.
+ * @param  clock specifies HCLK/8 or HCLK.
+ * @note   With HCLK, ticks are CPU cycles but the time conversions use division and
+ *         the 32-bit tick wraps 8 times faster (about 89 seconds at 48 MHz).
+ * @retval None.
+ */
+void HAL_TypeDef::SetTickClock(HAL_TickClkTypeDef clock) {
+    TickClock = clock;
+    if(clock == HAL_TICKCLK_HCLK)
+        SysTick->CTLR |= STK_CTLR_STCLK;
+    else
+        SysTick->CTLR &= ~STK_CTLR_STCLK;
+    HAL_TickProfileUpdate(RCC.HCLK.GetFreq());
+}
+
+/**
+ * @brief  Bind an interrupt to a VTF (vector table free) channel.
+ * @param  irq specifies the interrupt number.
+ * @param  handler interrupt handler, declared with __INTERRUPT. It is entered directly
+ *         without reading the vector table.
+ * @param  priority specifies the interrupt priority, see HAL_IRQ_PRIORITY.
+ * @note   Up to HAL_FAST_IRQ_COUNT interrupts can be bound at the same time.
+ *         The interrupt itself still has to be enabled with NVIC_EnableIRQ.
+ * @retval HAL status, HAL_BUSY if all the VTF channels are in use.
+ */
+HAL_StatusTypeDef HAL_TypeDef::SetFastIRQ(IRQn_Type irq, HAL_IRQHandlerTypeDef handler, uint8_t priority) {
+    uint8_t channel = HAL_FAST_IRQ_COUNT;
+    for(uint8_t i = 0U; i < HAL_FAST_IRQ_COUNT; i++) {
+        if((NVIC->VTFADDR[i] & 0x01U) && (NVIC->VTFIDR[i] == irq)) {
+            channel = i;
+            break;
+        }
+        if(!(NVIC->VTFADDR[i] & 0x01U) && (channel == HAL_FAST_IRQ_COUNT))
+            channel = i;
+    }
+    if(channel == HAL_FAST_IRQ_COUNT)
+        return HAL_BUSY;
+    NVIC_SetPriority(irq, priority);
+    SetVTFIRQ(HAL_ADDRESS(handler), irq, channel, ENABLE);
+    return HAL_OK;
+}
+
+/**
+ * @brief  Release the VTF channel bound to an interrupt, it goes back to the vector table.
+ * @param  irq specifies the interrupt number.
+ * @retval None.
+ */
+void HAL_TypeDef::ClearFastIRQ(IRQn_Type irq) {
+    for(uint8_t i = 0U; i < HAL_FAST_IRQ_COUNT; i++) {
+        if((NVIC->VTFADDR[i] & 0x01U) && (NVIC->VTFIDR[i] == irq))
+            SetVTFIRQ(NVIC->VTFADDR[i], irq, i, DISABLE);
+    }
+}
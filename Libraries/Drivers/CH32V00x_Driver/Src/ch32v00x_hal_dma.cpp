@@ -1,6 +1,10 @@
 
 #include "ch32v00x_hal_dma.h"
 
+#if (HAL_INLINE_ACCESSORS == 0U)
+#include "ch32v00x_hal_dma_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #define SET_SIZE(mSize, pSize) {                                        \
     REGS.CFGR = (REGS.CFGR & ~(DMA_CFGR_MSIZE | DMA_CFGR_PSIZE)) |      \
     ((mSize) << DMA_CFGR_MSIZE_Pos) |                                   \
@@ -20,8 +24,8 @@ HAL_StatusTypeDef DMA_ChannelTypeDef::Setup(void *src, uint8_t sSize, void *dest
     if(GetStatus() != HAL_OK)
         return HAL_ERROR;
     REGS.CFGR &= ~(DMA_CFGR_MEM2MEM | DMA_CFGR_DIR | DMA_CFGR_EN);
-    REGS.PADDR = (uint32_t)src;
-    REGS.MADDR = (uint32_t)dest;
+    REGS.PADDR = HAL_ADDRESS(src);
+    REGS.MADDR = HAL_ADDRESS(dest);
     REGS.CNTR = count;
     SET_SIZE(sSize, dSize);
     REGS.CFGR |= DMA_CFGR_EN;
@@ -40,11 +44,11 @@ HAL_StatusTypeDef DMA_ChannelTypeDef::MemCopy(void *src, void *dest, uint32_t si
     uint8_t elemSize;
     if(GetStatus() != HAL_OK)
         return HAL_ERROR;
-    if((size >= 4) && ((size % 4U) == 0) && (((uint32_t)src % 4U) == 0) && (((uint32_t)dest % 4U) == 0)) {
+    if((size >= 4) && ((size % 4U) == 0) && (((uintptr_t)src % 4U) == 0) && (((uintptr_t)dest % 4U) == 0)) {
         elemSize = 2U;
         size /= 4;
     }
-    else if((size >= 2) && ((size % 4U) == 0) && (((uint32_t)src % 2U) == 0) && (((uint32_t)dest % 2U) == 0)) {
+    else if((size >= 2) && ((size % 4U) == 0) && (((uintptr_t)src % 2U) == 0) && (((uintptr_t)dest % 2U) == 0)) {
         elemSize = 1U;
         size /= 2;
     }
@@ -52,8 +56,8 @@ HAL_StatusTypeDef DMA_ChannelTypeDef::MemCopy(void *src, void *dest, uint32_t si
         elemSize = 0U;
     REGS.CFGR &= ~(DMA_CFGR_DIR | DMA_CFGR_EN);
     REGS.CFGR |= DMA_CFGR_MEM2MEM;
-    REGS.PADDR = (uint32_t)src;
-    REGS.MADDR = (uint32_t)dest;
+    REGS.PADDR = HAL_ADDRESS(src);
+    REGS.MADDR = HAL_ADDRESS(dest);
     REGS.CNTR = size;
     SET_SIZE(elemSize, elemSize);
     REGS.CFGR |= DMA_CFGR_EN;
@@ -203,27 +207,6 @@ HAL_StatusTypeDef DMA_ChannelTypeDef::SetPINC(HAL_StateTypeDef enabled) {
     return HAL_OK;
 }
 
-/**
- * @brief  Return current status according to the internal DMA channel
- *         registers.
- * @retval HAL status.
- */
-HAL_StatusTypeDef DMA_ChannelTypeDef::GetStatus(void) {
-    if(!(REGS.CFGR & DMA_CFGR_EN))
-        return HAL_OK;
-    else if(!(REGS.CFGR & DMA_CFGR_CIRC) && REGS.CNTR == 0)
-        return HAL_OK;
-    return HAL_BUSY;
-}
-
-/**
- * @brief  Stop tranfer.
- * @retval None.
- */
-void DMA_ChannelTypeDef::Stop(void) {
-    REGS.CFGR &= ~DMA_CFGR_EN;
-}
-
 /**
  * @brief  Resets the DMA channel configuration to the default reset state.
  * @retval None.
@@ -235,26 +218,6 @@ void DMA_ChannelTypeDef::DeInit(void) {
     REGS.PADDR = 0U;
 }
 
-/**
- * @brief  Enable the DMA peripheral clock.
- * @note   This function will use RCC module to enable clock for DMA peripheral.
- * @retval None.
- */
-void DMA_TypeDef::EnableClock(void) {
-    if(this == &DMA1)
-        RCC.REGS.AHBPCENR |= RCC_AHBPCENR_DMA1EN;
-}
-
-/**
- * @brief  Disable the DMA peripheral clock.
- * @note   This function will use RCC module to disable clock for DMA peripheral.
- * @retval None.
- */
-void DMA_TypeDef::DisableClock(void) {
-    if(this == &DMA1)
-        RCC.REGS.AHBPCENR &= ~RCC_AHBPCENR_DMA1EN;
-}
-
 /**
  * @brief  Automatically selects a free DMA channel to perform data copying.
  * @note   This function will return used DMA channel. If no DMA is available,
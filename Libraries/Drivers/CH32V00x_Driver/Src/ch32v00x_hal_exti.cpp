@@ -1,6 +1,20 @@
 
 #include "ch32v00x_hal_exti.h"
 
+#ifndef EXTI_IRQ_PRIORITY
+#define EXTI_IRQ_PRIORITY                       HAL_IRQ_PRIORITY_LOW
+#endif /* EXTI_IRQ_PRIORITY */
+
+#define EXTI_IRQ_LINE_COUNT     (8U)
+#define EXTI_IRQ_LINE_MASK      ((1UL << EXTI_IRQ_LINE_COUNT) - 1U)
+
+static EXTI_CallbackTypeDef EXTI_Callbacks[EXTI_IRQ_LINE_COUNT];
+static uint16_t EXTI_DebounceMs[EXTI_IRQ_LINE_COUNT];
+static uint32_t EXTI_ReleaseTick[EXTI_IRQ_LINE_COUNT];
+static volatile uint32_t EXTI_DebounceMask = 0U;
+
+HAL_StatusTypeDef HAL_SetTickHook(HAL_IRQHandlerTypeDef hook);     /* Internal to the HAL, see ch32v00x_hal.cpp */
+
 /**
  * @brief  Returns the mask of the AFIO register for the corresponding pin.
  * @param  line specifies the line which need to be get mask of the CFGLR register.
@@ -60,9 +74,86 @@ void EXTI_TypeDef::Init(EXTI_PortTypeDef port, uint32_t line, EXTI_ModeTypeDef m
  * @retval None.
  */
 void EXTI_TypeDef::DeInit(uint32_t line) {
+    EXTI_DebounceMask &= ~line;
     AFIO.REGS.EXTICR &= ~HAL_EXTI_GetAFIOMask(line);
     REGS.INTENR &= ~line;
     REGS.EVENR &= ~line;
     REGS.RTENR &= ~line;
     REGS.FTENR &= ~line;
 }
+
+/**
+ * @brief  Register the interrupt callback for the specified EXTI lines.
+ * @param  line Specifies the lines to be attached to the callback.
+ *         This parameter can be any combination of EXTI_LINE_x where x can be (0..7).
+ * @param  callback pointer to the function called from EXTI7_0_IRQHandler with
+ *         the EXTI_LINE_x value of the line that triggered. NULL_PTR detaches the line.
+ * @param  debounceMs time in milliseconds during which the line stays masked in
+ *         INTENR after it triggered. 0 disables the debounce for the line.
+ * @note   The debounce is released from the SysTick interrupt. If the tick interrupt is
+ *         not enabled yet, it is enabled here with a 1ms interval (HAL.EnabelTickIRQ),
+ *         the tick interval sets the resolution of the debounce.
+ * @retval HAL status, HAL_ERROR if a debounce is requested while another driver
+ *         owns the tick hook. The lines are left unchanged in this case.
+ */
+HAL_StatusTypeDef EXTI_TypeDef::SetCallback(uint32_t line, EXTI_CallbackTypeDef callback, uint16_t debounceMs) {
+    line &= EXTI_IRQ_LINE_MASK;
+    if(debounceMs != 0U) {
+        if(HAL_SetTickHook(HAL_EXTI_TickHandler) != HAL_OK)
+            return HAL_ERROR;
+        if(NVIC_GetStatusIRQ(SysTicK_IRQn) == RESET)
+            HAL.EnabelTickIRQ(1U);
+    }
+    for(uint32_t mask = line; mask; mask &= mask - 1U) {
+        uint32_t index = __builtin_ctz(mask);
+        EXTI_Callbacks[index] = callback;
+        EXTI_DebounceMs[index] = debounceMs;
+    }
+    if(line) {
+        NVIC_SetPriority(EXTI7_0_IRQn, EXTI_IRQ_PRIORITY);
+        NVIC_EnableIRQ(EXTI7_0_IRQn);
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  Release the debounced EXTI lines whose masking time has elapsed.
+ * @note   This function is registered as tick hook by SetCallback when a debounce is set,
+ *         and then called from SysTick_Handler on every tick interrupt.
+ * @retval None.
+ */
+__RAMFUNC void HAL_EXTI_TickHandler(void) {
+    uint32_t mask = EXTI_DebounceMask;
+    uint32_t tick = SysTick->CNT;
+    for(; mask; mask &= mask - 1U) {
+        uint32_t index = __builtin_ctz(mask);
+        if((int32_t)(tick - EXTI_ReleaseTick[index]) >= 0) {
+            uint32_t line = 1UL << index;
+            EXTI_DebounceMask &= ~line;
+            EXTI.REGS.INTFR = line;
+            EXTI.REGS.INTENR |= line;
+        }
+    }
+}
+
+/**
+ * @brief  Interrupt handler for EXTI line 0 to 7.
+ * @note   INTFR is read once and only the pending lines are visited.
+ * @retval None.
+ */
+__RAMFUNC __INTERRUPT void EXTI7_0_IRQHandler(void) {
+    HAL_IRQ_SCOPE(HAL_IRQ_STATS_EXTI);
+    uint32_t pending = EXTI.REGS.INTFR & EXTI.REGS.INTENR & EXTI_IRQ_LINE_MASK;
+    EXTI.REGS.INTFR = pending;
+    for(; pending; pending &= pending - 1U) {
+        uint32_t index = __builtin_ctz(pending);
+        uint32_t line = 1UL << index;
+        if(EXTI_DebounceMs[index] != 0U) {
+            EXTI.REGS.INTENR &= ~line;
+            EXTI_ReleaseTick[index] = SysTick->CNT + HAL.MsToTicks(EXTI_DebounceMs[index]);
+            EXTI_DebounceMask |= line;
+        }
+        if(EXTI_Callbacks[index] != NULL_PTR)
+            EXTI_Callbacks[index](line);
+    }
+}
@@ -1,9 +1,33 @@
 
 #include "ch32v00x_hal_flash.h"
 
+#ifndef FLASH_IRQ_PRIORITY
+#define FLASH_IRQ_PRIORITY                      HAL_IRQ_PRIORITY_LOW
+#endif /* FLASH_IRQ_PRIORITY */
+
 #define FLASH_KEY1      (0x45670123UL)
 #define FLASH_KEY2      (0xCDEF89ABUL)
 
+#define FLASH_RDP_KEY   (0xA5U)
+#define FLASH_OB_USER_RESERVED  (0xC0U)
+
+typedef struct {
+    __IO uint16_t RDPR;
+    __IO uint16_t USER;
+    __IO uint16_t DATA0;
+    __IO uint16_t DATA1;
+    __IO uint16_t WRPR0;
+    __IO uint16_t WRPR1;
+} FLASH_OB_RegsTypeDef;
+
+#define FLASH_OB        ((FLASH_OB_RegsTypeDef *)UOB_BASE)
+
+static uint32_t FLASH_AsyncAddress;
+static uint32_t FLASH_AsyncEnd;
+static const uint8_t *FLASH_AsyncData;
+static FLASH_CallbackTypeDef FLASH_AsyncCallback;
+static volatile bool FLASH_AsyncBusy = false;
+
 /**
  * @brief  Unlock the FLASH.
  * @note   Before each erase or program flash action needs to be unlocked first.
@@ -43,7 +67,7 @@ void FLASH_TypeDef::Lock(void) {
  * @brief  Get FLASH status.
  * @retval HAL status.
  */
-HAL_StatusTypeDef FLASH_TypeDef::GetStatus(void) {
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::GetStatus(void) {
     if(REGS.STATR & FLASH_STATR_BUSY)
         return HAL_BUSY;
     else if(REGS.STATR & FLASH_STATR_WRPRTERR)
@@ -57,7 +81,7 @@ HAL_StatusTypeDef FLASH_TypeDef::GetStatus(void) {
  * @brief  Reset BUF.
  * @retval HAL status.
  */
-HAL_StatusTypeDef FLASH_TypeDef::BuffReset(void) {
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::BuffReset(void) {
     HAL_StatusTypeDef status;
     REGS.STATR |= FLASH_STATR_EOP;
     REGS.CTLR |= FLASH_CTLR_FTPG;
@@ -75,9 +99,9 @@ HAL_StatusTypeDef FLASH_TypeDef::BuffReset(void) {
  * @param  data specifies data to be loaded.
  * @retval HAL status.
  */
-HAL_StatusTypeDef FLASH_TypeDef::LoadWord(uint32_t address, uint32_t data) {
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::LoadWord(uint32_t address, uint32_t data) {
     HAL_StatusTypeDef status;
-    *(uint32_t *)address = data;
+    *(uint32_t *)(uintptr_t)address = data;
     REGS.STATR |= FLASH_STATR_EOP;
     REGS.CTLR |= FLASH_CTLR_FTPG;
     REGS.CTLR |= FLASH_CTLR_BUFLOAD;
@@ -94,7 +118,7 @@ HAL_StatusTypeDef FLASH_TypeDef::LoadWord(uint32_t address, uint32_t data) {
  *         of FLASH page 64B.
  * @retval HAL status.
  */
-HAL_StatusTypeDef FLASH_TypeDef::StartFastProgram(uint32_t address) {
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::StartFastProgram(uint32_t address) {
     HAL_StatusTypeDef status;
     REGS.STATR |= FLASH_STATR_EOP;
     REGS.CTLR |= FLASH_CTLR_FTPG;
@@ -112,11 +136,15 @@ HAL_StatusTypeDef FLASH_TypeDef::StartFastProgram(uint32_t address) {
  * @param  address specifies FLASH page address to be erased, it must be the starting address
  *         of FLASH page 64B or 1KB depending on the mode specified in eraseMode.
  * @param  eraseMode specifies the mode for 64B or 1KB FLASH page size.
+ * @note   This function and the program primitives run from RAM, so waiting for the end
+ *         of the operation does not fetch instructions from the busy FLASH.
  * @retval HAL status.
  */
-HAL_StatusTypeDef FLASH_TypeDef::ErasePage(uint32_t address, FLASH_EraseModeTypeDef eraseMode) {
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::ErasePage(uint32_t address, FLASH_EraseModeTypeDef eraseMode) {
     HAL_StatusTypeDef status;
     uint32_t ctlr;
+    if(FLASH_AsyncBusy)
+        return HAL_BUSY;
     if(eraseMode == FLASH_ERASE_1KB) {
         if(address & 0x03FFU)
             return HAL_ERROR;
@@ -141,6 +169,47 @@ HAL_StatusTypeDef FLASH_TypeDef::ErasePage(uint32_t address, FLASH_EraseModeType
     return status;
 }
 
+/**
+ * @brief  Erases a specified FLASH page 64B or 1KB in interrupt mode.
+ * @param  address specifies FLASH page address to be erased, it must be the starting address
+ *         of FLASH page 64B or 1KB depending on the mode specified in eraseMode.
+ * @param  eraseMode specifies the mode for 64B or 1KB FLASH page size.
+ * @param  callback function called from the FLASH interrupt when the erase is completed.
+ * @note   The function returns as soon as the erase is started. Instructions fetched from
+ *         FLASH stall until the end of the erase, so only code running from RAM keeps running.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASH_TypeDef::ErasePageAsync(uint32_t address, FLASH_EraseModeTypeDef eraseMode, FLASH_CallbackTypeDef callback) {
+    HAL_StatusTypeDef status;
+    uint32_t ctlr;
+    if(FLASH_AsyncBusy)
+        return HAL_BUSY;
+    if(eraseMode == FLASH_ERASE_1KB) {
+        if(address & 0x03FFU)
+            return HAL_ERROR;
+        ctlr = FLASH_CTLR_PER;
+    }
+    else {
+        if(address & 0x3FU)
+            return HAL_ERROR;
+        ctlr = FLASH_CTLR_FTER;
+    }
+    if((status = Unlock()) != HAL_OK)
+        return status;
+
+    FLASH_AsyncAddress = 0U;
+    FLASH_AsyncEnd = 0U;
+    FLASH_AsyncCallback = callback;
+    FLASH_AsyncBusy = true;
+    NVIC_SetPriority(FLASH_IRQn, FLASH_IRQ_PRIORITY);
+    NVIC_EnableIRQ(FLASH_IRQn);
+    REGS.STATR |= FLASH_STATR_EOP;
+    REGS.CTLR |= ctlr | FLASH_CTLR_EOPIE | FLASH_CTLR_ERRIE;
+    REGS.ADDR = address;
+    REGS.CTLR |= FLASH_CTLR_STRT;
+    return HAL_OK;
+}
+
 /**
  * @brief  Erases a specified FLASH page 64B or 1KB depending on the mode specified in eraseMode.
  * @param  address specifies the starting address where FLASH is written.
@@ -154,6 +223,9 @@ HAL_StatusTypeDef FLASH_TypeDef::WriteData(uint32_t address, void *data, uint32_
     uint32_t temp = 0xFFFFFFFFUL;
     uint8_t *buff = (uint8_t *)data;
 
+    if(FLASH_AsyncBusy)
+        return HAL_BUSY;
+
     if((status = Unlock()) == HAL_OK) {
         do {
             if((status = BuffReset()) != HAL_OK)
@@ -172,7 +244,7 @@ HAL_StatusTypeDef FLASH_TypeDef::WriteData(uint32_t address, void *data, uint32_
                 }
                 temp = 0xFFFFFFFFUL;
             }
-            if(((uint32_t)buff % 4U) == 0U) {
+            if(((uintptr_t)buff % 4U) == 0U) {
                 while((address + 4U) <= addrEnd) {
                     if((status = LoadWord(address, *(uint32_t *)buff)) != HAL_OK)
                         break;
@@ -215,3 +287,220 @@ HAL_StatusTypeDef FLASH_TypeDef::WriteData(uint32_t address, void *data, uint32_
     }
     return status;
 }
+
+/**
+ * @brief  Load the current page of the asynchronous write and start programming it.
+ * @note   The words of the page outside the written range are left erased. The function
+ *         returns as soon as the programming is started, the end of the operation is
+ *         signaled by the EOP interrupt. It runs from RAM as it is called from the FLASH
+ *         interrupt while the previous page has just been programmed.
+ * @retval HAL status.
+ */
+__RAMFUNC HAL_StatusTypeDef FLASH_TypeDef::ProgramNextPage(void) {
+    HAL_StatusTypeDef status;
+    uint32_t page = FLASH_AsyncAddress & 0xFFFFFFC0UL;
+    uint32_t end = ((page + 64U) < FLASH_AsyncEnd) ? (page + 64U) : FLASH_AsyncEnd;
+
+    if((status = BuffReset()) != HAL_OK)
+        return status;
+    for(uint32_t address = FLASH_AsyncAddress & 0xFFFFFFFCUL; address < end; address += 4U) {
+        uint32_t temp = 0xFFFFFFFFUL;
+        for(uint32_t i = 0U; i < 4U; i++) {
+            if(((address + i) >= FLASH_AsyncAddress) && ((address + i) < end))
+                ((uint8_t *)&temp)[i] = FLASH_AsyncData[address + i - FLASH_AsyncAddress];
+        }
+        if((status = LoadWord(address, temp)) != HAL_OK)
+            return status;
+    }
+    FLASH_AsyncData += end - FLASH_AsyncAddress;
+    FLASH_AsyncAddress = end;
+
+    REGS.STATR |= FLASH_STATR_EOP;
+    REGS.CTLR |= FLASH_CTLR_FTPG | FLASH_CTLR_EOPIE | FLASH_CTLR_ERRIE;
+    REGS.ADDR = page;
+    REGS.CTLR |= FLASH_CTLR_STRT;
+    return HAL_OK;
+}
+
+/**
+ * @brief  Write data to FLASH in interrupt mode.
+ * @param  address specifies the starting address where FLASH is written.
+ * @param  data pointer to data that needs to be written to FLASH, it must stay valid
+ *         until the operation is completed.
+ * @param  size size of data to write.
+ * @param  callback function called from the FLASH interrupt when the operation is completed.
+ * @note   The data is programmed 64B page by page, each page being started from the
+ *         FLASH interrupt, so the CPU is only held while a page is loaded. The pages must
+ *         have been erased before.
+ * @note   Instructions fetched from FLASH stall while a page is being programmed, so the
+ *         code that must keep running meanwhile (control loop, interrupt handlers) has to
+ *         be placed in RAM with __RAMFUNC.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASH_TypeDef::WriteDataAsync(uint32_t address, const void *data, uint32_t size, FLASH_CallbackTypeDef callback) {
+    HAL_StatusTypeDef status;
+    if(FLASH_AsyncBusy)
+        return HAL_BUSY;
+    if(size == 0U)
+        return HAL_ERROR;
+    if((status = Unlock()) != HAL_OK)
+        return status;
+
+    FLASH_AsyncAddress = address;
+    FLASH_AsyncEnd = address + size;
+    FLASH_AsyncData = (const uint8_t *)data;
+    FLASH_AsyncCallback = callback;
+    FLASH_AsyncBusy = true;
+    NVIC_SetPriority(FLASH_IRQn, FLASH_IRQ_PRIORITY);
+    NVIC_EnableIRQ(FLASH_IRQn);
+    if((status = ProgramNextPage()) != HAL_OK) {
+        REGS.CTLR &= ~(FLASH_CTLR_FTPG | FLASH_CTLR_EOPIE | FLASH_CTLR_ERRIE);
+        Lock();
+        FLASH_AsyncBusy = false;
+    }
+    return status;
+}
+
+/**
+ * @brief  Check if an asynchronous write is in progress.
+ * @retval true if the FLASH is busy.
+ */
+bool FLASH_TypeDef::IsBusy(void) {
+    return FLASH_AsyncBusy;
+}
+
+/**
+ * @brief  Interrupt handler for FLASH.
+ * @note   Start the next page of the asynchronous write, or lock the FLASH and call
+ *         the completion callback after the last page or the asynchronous erase.
+ *         The handler runs from RAM, the callback is only called once FLASH is idle.
+ * @retval None.
+ */
+__RAMFUNC __INTERRUPT void FLASH_IRQHandler(void) {
+    HAL_IRQ_SCOPE(HAL_IRQ_STATS_FLASH);
+    HAL_StatusTypeDef status = (FLASH.REGS.STATR & FLASH_STATR_WRPRTERR) ? HAL_ERROR : HAL_OK;
+
+    FLASH.REGS.CTLR &= ~(FLASH_CTLR_FTPG | FLASH_CTLR_PER | FLASH_CTLR_FTER | FLASH_CTLR_EOPIE | FLASH_CTLR_ERRIE);
+    FLASH.REGS.STATR |= FLASH_STATR_EOP | FLASH_STATR_WRPRTERR;
+    if(!FLASH_AsyncBusy)
+        return;
+    if((status == HAL_OK) && (FLASH_AsyncAddress < FLASH_AsyncEnd)) {
+        if((status = FLASH.ProgramNextPage()) == HAL_OK)
+            return;
+        FLASH.REGS.CTLR &= ~(FLASH_CTLR_FTPG | FLASH_CTLR_EOPIE | FLASH_CTLR_ERRIE);
+    }
+    FLASH.Lock();
+    FLASH_AsyncBusy = false;
+    if(FLASH_AsyncCallback != NULL_PTR)
+        FLASH_AsyncCallback(status);
+}
+
+/**
+ * @brief  Program one option byte, its complement is generated by the hardware.
+ * @param  address specifies the option byte address.
+ * @param  data specifies the value to be programmed.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASH_TypeDef::ProgramOptionByte(__IO uint16_t *address, uint8_t data) {
+    HAL_StatusTypeDef status;
+    REGS.STATR |= FLASH_STATR_EOP;
+    *address = data;
+    do {
+        status = GetStatus();
+    } while(status == HAL_BUSY);
+    return status;
+}
+
+/**
+ * @brief  Read the user option bytes currently programmed.
+ * @param  optionBytes structure to be filled, it can be modified and written back with SetOptionBytes.
+ * @note   The values are read from the option bytes area, so they already include a
+ *         change that has not been loaded by a reset yet.
+ * @retval None.
+ */
+void FLASH_TypeDef::GetOptionBytes(FLASH_OptionBytesTypeDef &optionBytes) {
+    uint8_t user = FLASH_OB->USER & UOB_USER_USER;
+    optionBytes.RstMode = (FLASH_OB_RstModeTypeDef)((user & UOB_USER_RSTMODE) >> UOB_USER_RSTMODE_Pos);
+    optionBytes.BootMode = (user & UOB_USER_STARTMODE) ? FLASH_OB_BOOT_SYSTEM : FLASH_OB_BOOT_USER;
+    optionBytes.IwdgHardware = !(user & UOB_USER_IWDGSW);
+    optionBytes.StandbyReset = !(user & UOB_USER_STANDYRST);
+    optionBytes.Data0 = FLASH_OB->DATA0 & UOB_DATA0_DATA0;
+    optionBytes.Data1 = FLASH_OB->DATA1 & UOB_DATA1_DATA1;
+    optionBytes.WriteProtect = (uint16_t)~((FLASH_OB->WRPR0 & UOB_WRPR0_WRPR0) | ((FLASH_OB->WRPR1 & UOB_WRPR1_WRPR1) << 8U));
+}
+
+/**
+ * @brief  Write all the user option bytes in a single erase and program cycle.
+ * @param  optionBytes new values, usually read with GetOptionBytes and modified.
+ * @note   Nothing is erased if the option bytes already hold these values.
+ *         The read protection state is kept. The new values are applied after the next reset.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASH_TypeDef::SetOptionBytes(const FLASH_OptionBytesTypeDef &optionBytes) {
+    HAL_StatusTypeDef status;
+    FLASH_OptionBytesTypeDef current;
+    uint8_t user = (FLASH_OB->USER & UOB_USER_STOPRST) | FLASH_OB_USER_RESERVED;
+    uint16_t wrpr = ~optionBytes.WriteProtect;
+
+    user |= (uint8_t)optionBytes.RstMode << UOB_USER_RSTMODE_Pos;
+    if(optionBytes.BootMode == FLASH_OB_BOOT_SYSTEM)
+        user |= UOB_USER_STARTMODE;
+    if(!optionBytes.IwdgHardware)
+        user |= UOB_USER_IWDGSW;
+    if(!optionBytes.StandbyReset)
+        user |= UOB_USER_STANDYRST;
+
+    GetOptionBytes(current);
+    if(((FLASH_OB->USER & UOB_USER_USER) == (user & UOB_USER_USER)) && (current.Data0 == optionBytes.Data0) &&
+       (current.Data1 == optionBytes.Data1) && (current.WriteProtect == optionBytes.WriteProtect))
+        return HAL_OK;
+
+    if(FLASH_AsyncBusy)
+        return HAL_BUSY;
+    if((status = Unlock()) != HAL_OK)
+        return status;
+    REGS.OBKEYR = FLASH_KEY1;
+    REGS.OBKEYR = FLASH_KEY2;
+    if(!(REGS.CTLR & FLASH_CTLR_OBWRE)) {
+        Lock();
+        return HAL_ERROR;
+    }
+
+    REGS.STATR |= FLASH_STATR_EOP;
+    REGS.CTLR |= FLASH_CTLR_OBER;
+    REGS.CTLR |= FLASH_CTLR_STRT;
+    do {
+        status = GetStatus();
+    } while(status == HAL_BUSY);
+    REGS.CTLR &= ~FLASH_CTLR_OBER;
+
+    if(status == HAL_OK) {
+        REGS.CTLR |= FLASH_CTLR_OBPG;
+        do {
+            if((status = ProgramOptionByte(&FLASH_OB->RDPR, (REGS.OBR & FLASH_OBR_RDPRT) ? 0x00U : FLASH_RDP_KEY)) != HAL_OK)
+                break;
+            if((status = ProgramOptionByte(&FLASH_OB->USER, user)) != HAL_OK)
+                break;
+            if((status = ProgramOptionByte(&FLASH_OB->DATA0, optionBytes.Data0)) != HAL_OK)
+                break;
+            if((status = ProgramOptionByte(&FLASH_OB->DATA1, optionBytes.Data1)) != HAL_OK)
+                break;
+            if((status = ProgramOptionByte(&FLASH_OB->WRPR0, wrpr & 0xFFU)) != HAL_OK)
+                break;
+            status = ProgramOptionByte(&FLASH_OB->WRPR1, wrpr >> 8U);
+        } while(0);
+        REGS.CTLR &= ~FLASH_CTLR_OBPG;
+    }
+    REGS.CTLR &= ~FLASH_CTLR_OBWRE;
+    Lock();
+    return status;
+}
+
+/**
+ * @brief  Get the sectors currently write protected.
+ * @note   This is the protection loaded at reset, see GetOptionBytes for the programmed value.
+ * @retval Bit n set when the 1KB sector n is write protected.
+ */
+uint16_t FLASH_TypeDef::GetWriteProtect(void) {
+    return (uint16_t)~REGS.WPR;
+}
@@ -0,0 +1,88 @@
+
+#include "ch32v00x_hal_irqstats.h"
+
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+static HAL_IRQStatsTypeDef HAL_IRQStats[HAL_IRQ_STATS_COUNT];
+#else
+static const HAL_IRQStatsTypeDef HAL_IRQStats[HAL_IRQ_STATS_COUNT] = {};
+#endif
+
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+
+static uint32_t HAL_IRQStatsBucket(uint32_t ticks) {
+    uint32_t bucket = 0U;
+    while(ticks && (bucket < (HAL_IRQ_STATS_BUCKETS - 1U))) {
+        ticks >>= 1U;
+        bucket++;
+    }
+    return bucket;
+}
+
+/**
+ * @brief  Halve the buckets and the call count of a handler, before a bucket overflows.
+ * @param  stats statistics of the handler.
+ * @retval None.
+ */
+static __RAMFUNC void HAL_IRQStatsScale(HAL_IRQStatsTypeDef *stats) {
+    stats->Count >>= 1U;
+    for(uint32_t i = 0U; i < HAL_IRQ_STATS_BUCKETS; i++) {
+        stats->Duration[i] >>= 1U;
+        stats->Latency[i] >>= 1U;
+    }
+}
+
+/**
+ * @brief  Add the duration of a handler call to its statistics.
+ * @param  id specifies the handler.
+ * @param  duration handler duration in SysTick ticks.
+ * @retval None.
+ */
+__RAMFUNC void HAL_IRQStatsRecord(HAL_IRQStatsIdTypeDef id, uint32_t duration) {
+    HAL_IRQStatsTypeDef *stats = &HAL_IRQStats[id];
+    uint8_t *bucket = &stats->Duration[HAL_IRQStatsBucket(duration)];
+    if(*bucket == 0xFFU)
+        HAL_IRQStatsScale(stats);
+    stats->Count++;
+    (*bucket)++;
+    if(duration > stats->MaxDuration)
+        stats->MaxDuration = (duration > 0xFFFFU) ? 0xFFFFU : duration;
+}
+
+/**
+ * @brief  Add the entry latency of a handler call to its statistics.
+ * @param  id specifies the handler.
+ * @param  latency ticks between the time the interrupt was due and the handler entry.
+ * @retval None.
+ */
+__RAMFUNC void HAL_IRQStatsLatency(HAL_IRQStatsIdTypeDef id, uint32_t latency) {
+    HAL_IRQStatsTypeDef *stats = &HAL_IRQStats[id];
+    uint8_t *bucket = &stats->Latency[HAL_IRQStatsBucket(latency)];
+    if(*bucket == 0xFFU)
+        HAL_IRQStatsScale(stats);
+    (*bucket)++;
+    if(latency > stats->MaxLatency)
+        stats->MaxLatency = (latency > 0xFFFFU) ? 0xFFFFU : latency;
+}
+
+#endif /* HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM */
+
+/**
+ * @brief  Get the statistics of a handler.
+ * @param  id specifies the handler.
+ * @note   All the values stay 0 unless HAL_IRQ_STATS includes HAL_IRQ_STATS_HISTOGRAM.
+ * @retval Pointer to the handler statistics.
+ */
+const HAL_IRQStatsTypeDef *HAL_GetIRQStats(HAL_IRQStatsIdTypeDef id) {
+    return &HAL_IRQStats[id];
+}
+
+/**
+ * @brief  Clear the statistics of all the handlers.
+ * @retval None.
+ */
+void HAL_ResetIRQStats(void) {
+#if (HAL_IRQ_STATS & HAL_IRQ_STATS_HISTOGRAM)
+    for(uint32_t i = 0U; i < sizeof(HAL_IRQStats); i++)
+        ((uint8_t *)HAL_IRQStats)[i] = 0U;
+#endif
+}
@@ -57,12 +57,37 @@ void PWR_TypeDef::SetAWU(PWR_AwuDivTypeDef div, uint8_t windowValue) {
         REGS.AWUCSR &= ~PWR_AWUCSR_AWUEN;
 }
 
+/**
+ * @brief  Enable or disable EXTI lines as event sources to wake up from standby mode.
+ * @param  line Specifies the lines to be used as wake-up sources.
+ *         This parameter can be any combination of EXTI_LINE_x where x can be (0..9).
+ *         EXTI_LINE_8 is the PVD output and EXTI_LINE_9 is the AWU.
+ * @param  state specifies whether the lines wake up the MCU or not.
+ * @note   The port and the trigger edge of the GPIO lines must be set by EXTI.Init
+ *         before. The PVD and AWU lines are set to rising edge by this function.
+ *         The interrupt enable state of the lines is not changed.
+ * @retval None.
+ */
+void PWR_TypeDef::SetWakeupSource(uint32_t line, HAL_StateTypeDef state) {
+    if(state == DISABLE) {
+        EXTI.REGS.EVENR &= ~line;
+        return;
+    }
+    EXTI.REGS.RTENR |= line & (EXTI_LINE_8 | EXTI_LINE_9);
+    EXTI.REGS.EVENR |= line;
+}
+
 /**
  * @brief  Enter standby mode with mode specified by mode parameter.
  * @param  mode specifies the standby mode.
- * @retval None.
+ * @note   The system clock falls back to HSI on wake-up. The clock configuration
+ *         active before entering standby mode is restored before returning.
+ * @retval HAL status of the clock restoration.
  */
-void PWR_TypeDef::EnterStandbyMode(PWR_StanbyModeTypeDef mode) {
+HAL_StatusTypeDef PWR_TypeDef::EnterStandbyMode(PWR_StanbyModeTypeDef mode) {
+    uint32_t ctlr = RCC.REGS.CTLR;
+    uint32_t cfgr0 = RCC.REGS.CFGR0;
+
     REGS.CTLR &= ~PWR_CTLR_PDDS;
     REGS.CTLR |= PWR_CTLR_PDDS;
 
@@ -74,6 +99,8 @@ void PWR_TypeDef::EnterStandbyMode(PWR_StanbyModeTypeDef mode) {
         __WFE();
 
     NVIC->SCTLR &= ~PFIC_SCTLR_SLEEPDEEP;
+
+    return RCC.Resume(ctlr, cfgr0);
 }
 
 /**
@@ -1,5 +1,6 @@
 
-#include "ch32v00x_hal_rcc.h"
+/* Included through ch32v00x_hal.h so RCC is complete before the inline accessors using it */
+#include "ch32v00x_hal.h"
 
 static uint32_t SystemCoreClock = HSI_VALUE;
 
@@ -24,6 +25,7 @@ void CoreClockUpdate(void) {
 
     if(SystemCoreClock != ret) {
         SystemCoreClock = ret;
+        HAL_TickProfileUpdate(ret);
         if(ret > HSI_VALUE)
             FLASH.REGS.ACTLR |= (FLASH.REGS.ACTLR & ~FLASH_ACTLR_LATENCY) | (1U << FLASH_ACTLR_LATENCY_Pos);
         else
@@ -295,6 +297,120 @@ uint32_t RCC_OutClkTypeDef::GetFreq(void) {
     }
 }
 
+/**
+ * @brief  Switch the clock tree to a profile computed by RCC_Profile.
+ * @param  profile specifies the clock profile to be applied.
+ * @note   The HCLK frequency, flash latency and the USART1/I2C1 clock values come
+ *         precomputed from the profile, so no frequency is derived at runtime.
+ *         PLL and HSE are stopped when the profile does not use them.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef RCC_TypeDef::SetProfile(const RCC_ProfileTypeDef &profile) {
+    uint32_t timeout = 0xFFU;
+    uint32_t source = (profile.CFGR0 & RCC_CFGR0_SW) >> RCC_CFGR0_SW_Pos;
+    if((profile.CTLR & RCC_CTLR_HSEON) && !(REGS.CTLR & RCC_CTLR_HSERDY)) {
+        AFIO.REGS.PCFR1 |= AFIO_PCFR1_PA12_RM;
+        REGS.CTLR |= RCC_CTLR_HSEON;
+        while((!(REGS.CTLR & RCC_CTLR_HSERDY)) && (timeout--));
+        if(!(REGS.CTLR & RCC_CTLR_HSERDY))
+            return HAL_ERROR;
+    }
+    if(profile.CTLR & RCC_CTLR_PLLON) {
+        if((REGS.CTLR & RCC_CTLR_PLLRDY) && ((REGS.CFGR0 ^ profile.CFGR0) & RCC_CFGR0_PLLSRC)) {
+            if(SysClk.GetSource() == RCC_SYSCLKSRC_PLL) {
+                REGS.CTLR |= RCC_CTLR_HSION;
+                while(!(REGS.CTLR & RCC_CTLR_HSIRDY));
+                REGS.CFGR0 &= ~RCC_CFGR0_SW;
+                while(REGS.CFGR0 & RCC_CFGR0_SWS);
+            }
+            REGS.CTLR &= ~RCC_CTLR_PLLON;
+        }
+        if(!(REGS.CTLR & RCC_CTLR_PLLRDY)) {
+            timeout = 0xFFU;
+            REGS.CFGR0 = (REGS.CFGR0 & ~RCC_CFGR0_PLLSRC) | (profile.CFGR0 & RCC_CFGR0_PLLSRC);
+            REGS.CTLR |= RCC_CTLR_PLLON;
+            while((!(REGS.CTLR & RCC_CTLR_PLLRDY)) && (timeout--));
+            if(!(REGS.CTLR & RCC_CTLR_PLLRDY))
+                return HAL_ERROR;
+        }
+    }
+    else if(source == RCC_SYSCLKSRC_HSI) {
+        REGS.CTLR |= RCC_CTLR_HSION;
+        while(!(REGS.CTLR & RCC_CTLR_HSIRDY));
+    }
+
+    if(profile.ACTLR > (FLASH.REGS.ACTLR & FLASH_ACTLR_LATENCY))
+        FLASH.REGS.ACTLR = (FLASH.REGS.ACTLR & ~FLASH_ACTLR_LATENCY) | profile.ACTLR;
+    timeout = 0xFFU;
+    REGS.CFGR0 = (REGS.CFGR0 & ~(RCC_CFGR0_SW | RCC_CFGR0_HPRE)) | (profile.CFGR0 & (RCC_CFGR0_SW | RCC_CFGR0_HPRE));
+    while(((REGS.CFGR0 & RCC_CFGR0_SWS) != (source << RCC_CFGR0_SWS_Pos)) && (timeout--));
+    if((REGS.CFGR0 & RCC_CFGR0_SWS) != (source << RCC_CFGR0_SWS_Pos)) {
+        CoreClockUpdate();
+        return HAL_ERROR;
+    }
+    FLASH.REGS.ACTLR = (FLASH.REGS.ACTLR & ~FLASH_ACTLR_LATENCY) | profile.ACTLR;
+    SystemCoreClock = profile.HCLK;
+    HAL_TickProfileUpdate(profile.HCLK);
+
+    if(!(profile.CTLR & RCC_CTLR_PLLON))
+        REGS.CTLR &= ~RCC_CTLR_PLLON;
+    if(!(profile.CTLR & RCC_CTLR_HSEON) && (REGS.CTLR & RCC_CTLR_HSEON)) {
+        REGS.CTLR &= ~RCC_CTLR_HSEON;
+        AFIO.REGS.PCFR1 &= ~AFIO_PCFR1_PA12_RM;
+    }
+
+    if(profile.USART_BRR != 0U)
+        USART1.REGS.BRR = profile.USART_BRR;
+    if(profile.I2C_CKCFGR != 0U) {
+        uint16_t pe = I2C1.REGS.CTLR1 & I2C_CTLR1_PE;
+        I2C1.REGS.CTLR1 &= ~I2C_CTLR1_PE;
+        I2C1.REGS.CTLR2 = (I2C1.REGS.CTLR2 & ~I2C_CTLR2_FREQ) | profile.I2C_FREQ;
+        I2C1.REGS.CKCFGR = profile.I2C_CKCFGR;
+        I2C1.REGS.CTLR1 |= pe;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  Restore a clock configuration previously read from the CTLR and CFGR0 registers.
+ * @param  ctlr saved value of the CTLR register.
+ * @param  cfgr0 saved value of the CFGR0 register.
+ * @note   After waking up from standby mode the system clock falls back to HSI. This
+ *         function restarts HSE and PLL as needed, switches the system clock back and
+ *         updates the HCLK frequency once at the end. The HCLK frequency is also updated
+ *         when an oscillator fails to start, the core then keeps running on HSI.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef RCC_TypeDef::Resume(uint32_t ctlr, uint32_t cfgr0) {
+    uint32_t timeout = 0xFFU;
+    uint32_t source = (cfgr0 & RCC_CFGR0_SW) >> RCC_CFGR0_SW_Pos;
+    if((ctlr & RCC_CTLR_HSEON) && !(REGS.CTLR & RCC_CTLR_HSERDY)) {
+        REGS.CTLR |= RCC_CTLR_HSEON;
+        while((!(REGS.CTLR & RCC_CTLR_HSERDY)) && (timeout--));
+        if(!(REGS.CTLR & RCC_CTLR_HSERDY)) {
+            CoreClockUpdate();
+            return HAL_ERROR;
+        }
+    }
+    if((ctlr & RCC_CTLR_PLLON) && !(REGS.CTLR & RCC_CTLR_PLLRDY)) {
+        timeout = 0xFFU;
+        REGS.CFGR0 = (REGS.CFGR0 & ~RCC_CFGR0_PLLSRC) | (cfgr0 & RCC_CFGR0_PLLSRC);
+        REGS.CTLR |= RCC_CTLR_PLLON;
+        while((!(REGS.CTLR & RCC_CTLR_PLLRDY)) && (timeout--));
+        if(!(REGS.CTLR & RCC_CTLR_PLLRDY)) {
+            CoreClockUpdate();
+            return HAL_ERROR;
+        }
+    }
+    if((source == RCC_SYSCLKSRC_PLL) && ((cfgr0 & RCC_CFGR0_HPRE) == 0U))
+        FLASH.REGS.ACTLR = (FLASH.REGS.ACTLR & ~FLASH_ACTLR_LATENCY) | (1U << FLASH_ACTLR_LATENCY_Pos);
+    timeout = 0xFFU;
+    REGS.CFGR0 = cfgr0 & ~RCC_CFGR0_SWS;
+    while(((REGS.CFGR0 & RCC_CFGR0_SWS) != (source << RCC_CFGR0_SWS_Pos)) && (timeout--));
+    CoreClockUpdate();
+    return ((REGS.CFGR0 & RCC_CFGR0_SWS) == (source << RCC_CFGR0_SWS_Pos)) ? HAL_OK : HAL_ERROR;
+}
+
 /**
  * @brief  Resets the RCC clock configuration to the default reset state.
  * @retval None.
@@ -307,4 +423,5 @@ void RCC_TypeDef::DeInit(void) {
     REGS.CFGR0 &= (uint32_t)0xFFFEFFFFUL;
     REGS.INTR = 0x009F0000UL;
     SystemCoreClock = HSI_VALUE;
-}
\ No newline at end of file
+    HAL_TickProfileUpdate(HSI_VALUE);
+}
\ No newline at end of file
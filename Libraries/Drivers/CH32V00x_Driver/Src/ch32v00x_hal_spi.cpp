@@ -1,6 +1,10 @@
 
 #include "ch32v00x_hal_spi.h"
 
+#if (HAL_INLINE_ACCESSORS == 0U)
+#include "ch32v00x_hal_spi_inline.h"
+#endif /* HAL_INLINE_ACCESSORS */
+
 #define SPI_MODE_SLAVE_FULL_DUPLEX      (0U)
 #define SPI_MODE_SLAVE_RECEIVE          (SPI_CTLR1_BIDIMODE | SPI_CTLR1_RXONLY)
 #define SPI_MODE_MASTER_FULL_DUPLEX     (SPI_CTLR1_MSTR)
@@ -57,66 +61,6 @@ void SPI_ModeTypeDef::MasterTransmit(void) {
     SetMode(SPI_MODE_MASTER_TRANSMIT);
 }
 
-/**
- * @brief  Set 8 bits mode data size when transmitting and receiving for SPI.
- * @retval None.
- */
-void SPI_DataSizeTypeDef::Mode8Bit(void) {
-    REGS.CTLR1 &= ~SPI_CTLR1_DFF;
-}
-
-/**
- * @brief  Set 16 bits mode data size when transmitting and receiving for SPI.
- * @retval None.
- */
-void SPI_DataSizeTypeDef::Mode16Bit(void) {
-    REGS.CTLR1 |= SPI_CTLR1_DFF;
-}
-
-/**
- * @brief  Check whether the current SPI configuration is 8-bit mode or not.
- * @retval Boolean.
- */
-bool SPI_DataSizeTypeDef::IsMode8Bit(void) {
-    return (REGS.CTLR1 & SPI_CTLR1_DFF) == 0U;
-}
-
-/**
- * @brief  Check whether the current SPI configuration is 16-bit mode or not.
- * @retval Boolean.
- */
-bool SPI_DataSizeTypeDef::IsMode16Bit(void) {
-    return (REGS.CTLR1 & SPI_CTLR1_DFF) == SPI_CTLR1_DFF;
-}
-
-/**
- * @brief  Set polarity for SPI clock signal.
- * @param  polarity specifies the polarity (CLK idle state) to be set for SPI.
- * @retval None.
- */
-void SPI_ClkTypeDef::SetPolarity(SPI_PolarityTypeDef polarity) {
-    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_CPOL) | (polarity << SPI_CTLR1_CPOL_Pos);
-}
-
-/**
- * @brief  Set phase for SPI clock signal.
- * @param  phase specifies the phase (sampling point) to be set for SPI.
- * @retval None.
- */
-void SPI_ClkTypeDef::SetPhase(SPI_PhaseTypeDef phase) {
-    uint32_t polarity = (REGS.CTLR1 & SPI_CTLR1_CPOL) >> SPI_CTLR1_CPOL_Pos;
-    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_CPHA) | ((polarity ^ phase) << SPI_CTLR1_CPHA_Pos);
-}
-
-/**
- * @brief  Set baudrate for SPI clock signal.
- * @param  baudRate specifies the baudRate to be set for SPI.
- * @retval None.
- */
-void SPI_ClkTypeDef::SetBaudRate(SPI_BaudRateTypeDef baudRate) {
-    REGS.CTLR1 = (REGS.CTLR1 & ~SPI_CTLR1_BR) | (baudRate << SPI_CTLR1_BR_Pos);
-}
-
 /**
  * @brief  Disable SPI NSS PIN.
  * @retval None.
@@ -146,22 +90,6 @@ void SPI_NssTypeDef::ActiveHight(void) {
     REGS.CTLR1 |= SPI_CTLR1_SSI;
 }
 
-/**
- * @brief  Set MSB will be sent first.
- * @retval None.
- */
-void SPI_FirstBitTypeDef::MSBFirst(void) {
-    REGS.CTLR1 &= ~SPI_CTLR1_LSBFIRST;
-}
-
-/**
- * @brief  Set LSB will be sent first.
- * @retval None.
- */
-void SPI_FirstBitTypeDef::LSBFirst(void) {
-    REGS.CTLR1 |= SPI_CTLR1_LSBFIRST;
-}
-
 /**
  * @brief  Enable hardware CRC checksum.
  * @param  polynomial specifies the polynomial for the CRC calculation.
@@ -172,71 +100,6 @@ void SPI_CrcTypeDef::Enable(uint32_t polynomial) {
     REGS.CRCR = polynomial;
 }
 
-/**
- * @brief  Disabe hardware CRC checksum.
- * @retval None.
- */
-void SPI_CrcTypeDef::Disable(void) {
-    REGS.CTLR1 &= ~SPI_CTLR1_CRCEN;
-}
-
-/**
- * @brief  Return state of CRC.
- * @retval Boolean.
- */
-bool SPI_CrcTypeDef::IsEnable(void) {
-    return (REGS.CTLR1 & SPI_CTLR1_CRCEN) == SPI_CTLR1_CRCEN;
-}
-
-/**
- * @brief  Enable the SPI peripheral clock.
- * @note   This function will use RCC module to enable clock for SPI peripheral.
- * @retval None.
- */
-void SPI_TypeDef::EnableClock(void) {
-    if(this == &SPI1)
-        RCC.REGS.APB2PCENR |= RCC_APB2PCENR_SPI1EN;
-}
-
-/**
- * @brief  Disable the SPI peripheral clock.
- * @note   This function will use RCC module to disable clock for SPI peripheral.
- * @retval None.
- */
-void SPI_TypeDef::DisableClock(void) {
-    if(this == &SPI1)
-        RCC.REGS.APB2PCENR &= ~RCC_APB2PCENR_SPI1EN;
-}
-
-/**
- * @brief  Enable SPI.
- * @note   To be able to transmit and receive data, SPI must be enabled.
- * @retval None.
- */
-void SPI_TypeDef::Enable(void) {
-    REGS.CTLR1 |= SPI_CTLR1_SPE;
-}
-
-/**
- * @brief  Disable SPI.
- * @retval None.
- */
-void SPI_TypeDef::Disable(void) {
-    REGS.CTLR1 &= ~SPI_CTLR1_SPE;
-}
-
-/**
- * @brief  Get current SPI status.
- * @retval SPI status.
- */
-SPI_StatusTypeDef SPI_TypeDef::GetStatus(void) {
-    if(REGS.STATR & SPI_STATR_BSY)
-        return HAL_SPI_STATE_BUSY;
-    if(!(REGS.CTLR1 & SPI_CTLR1_SPE))
-        return HAL_SPI_STATE_RESET;
-    return HAL_SPI_STATE_READY;
-}
-
 /**
  * @brief  Transmit an amount of uint8_t data in blocking mode.
  * @param  txData pointer to transmission data buffer.
@@ -0,0 +1,90 @@
+
+#include "ch32v00x_hal_wwdg.h"
+
+#ifndef WWDG_IRQ_PRIORITY
+#define WWDG_IRQ_PRIORITY                       HAL_IRQ_PRIORITY_LOW
+#endif /* WWDG_IRQ_PRIORITY */
+
+static uint8_t WWDG_Counter = WWDG_CTLR_T;
+static WWDG_CallbackTypeDef WWDG_Callback = NULL_PTR;
+
+/**
+ * @brief  Enable the WWDG peripheral clock.
+ * @note   This function will use RCC module to enable clock for WWDG peripheral.
+ * @retval None.
+ */
+void WWDG_TypeDef::EnableClock(void) {
+    RCC.REGS.APB1PCENR |= RCC_APB1PCENR_WWDGEN;
+}
+
+/**
+ * @brief  Disable the WWDG peripheral clock.
+ * @note   This function will use RCC module to disable clock for WWDG peripheral.
+ * @retval None.
+ */
+void WWDG_TypeDef::DisableClock(void) {
+    RCC.REGS.APB1PCENR &= ~RCC_APB1PCENR_WWDGEN;
+}
+
+/**
+ * @brief  Configure prescaler, window and reload counter of the WWDG.
+ * @param  config values computed by WWDG_Config.
+ * @param  callback function called from the early wakeup interrupt, just before the reset.
+ *         The WWDG is not refreshed, there is one WWDG clock period left to save the state.
+ * @note   The early wakeup interrupt cannot be disabled again until the next reset.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef WWDG_TypeDef::Init(const WWDG_ConfigTypeDef &config, WWDG_CallbackTypeDef callback) {
+    if(config.Timeout == 0U)
+        return HAL_ERROR;
+    WWDG_Counter = config.Counter;
+    WWDG_Callback = callback;
+    REGS.CFGR = config.CFGR;
+    if(callback != NULL_PTR) {
+        REGS.STATR = 0U;
+        REGS.CFGR |= WWDG_CFGR_EWI;
+        NVIC_SetPriority(WWDG_IRQn, WWDG_IRQ_PRIORITY);
+        NVIC_EnableIRQ(WWDG_IRQn);
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  Start the WWDG with the configured counter value.
+ * @note   Once started, the WWDG can only be stopped by a reset.
+ * @retval None.
+ */
+void WWDG_TypeDef::Start(void) {
+    REGS.CTLR = WWDG_CTLR_WDGA | WWDG_Counter;
+}
+
+/**
+ * @brief  Refresh the WWDG counter.
+ * @note   Refreshing before the configured window is open resets the MCU.
+ * @retval None.
+ */
+void WWDG_TypeDef::Reset(void) {
+    REGS.CTLR = WWDG_Counter;
+}
+
+/**
+ * @brief  Resets the WWDG peripheral registers to their default reset values.
+ * @retval None.
+ */
+void WWDG_TypeDef::DeInit(void) {
+    NVIC_DisableIRQ(WWDG_IRQn);
+    RCC.REGS.APB1PRSTR |= RCC_APB1PRSTR_WWDGRST;
+    RCC.REGS.APB1PRSTR &= ~RCC_APB1PRSTR_WWDGRST;
+    WWDG_Callback = NULL_PTR;
+}
+
+/**
+ * @brief  Interrupt handler for WWDG early wakeup.
+ * @retval None.
+ */
+__INTERRUPT void WWDG_IRQHandler(void) {
+    HAL_IRQ_SCOPE(HAL_IRQ_STATS_WWDG);
+    WWDG.REGS.STATR = 0U;
+    if(WWDG_Callback != NULL_PTR)
+        WWDG_Callback();
+}
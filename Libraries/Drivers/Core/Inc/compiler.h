@@ -11,13 +11,25 @@
 #define       __O               volatile                    /*  defines 'write only' permissions    */
 #define       __IO              volatile                    /*  defines 'read / write' permissions  */
 
-#if defined(__CC_ARM)
+#if defined(HAL_SIMULATOR)
+    /* Host build running on the register-level simulator (Libraries/Simulator) */
+    #define __ASM                   __asm
+    #define __INLINE                inline
+    #define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+    #define __INTERRUPT
+    #define __WEAK                  __attribute__((weak))
+    #define __USED                  __attribute__((used))
+    #define __RAMFUNC               __attribute__((noinline))
+    #define __NOINIT
+#elif defined(__CC_ARM)
     #define __ASM                   __asm                   /*!< asm keyword for ARM Compiler          */
     #define __INLINE                __inline                /*!< inline keyword for ARM Compiler       */
     #define __STATIC_FORCEINLINE    __forceinline static inline
     #define __INTERRUPT             __attribute__((interrupt()))
     #define __WEAK                  __attribute__((weak))
     #define __USED                  __attribute__((used))
+    #define __RAMFUNC               __attribute__((section(".ramfunc"), noinline))  /*!< Function copied to and executed from RAM */
+    #define __NOINIT                __attribute__((section(".noinit")))             /*!< Variable left untouched by the startup code, kept across resets */
 #elif defined(__ICCARM__)
     #define __ASM                    __asm                  /*!< asm keyword for IAR Compiler          */
     #define __INLINE                inline                  /*!< inline keyword for IAR Compiler. Only avaiable in High optimization mode! */
@@ -25,6 +37,8 @@
     #define __INTERRUPT             __attribute__((interrupt()))
     #define __WEAK                  __attribute__((weak))
     #define __USED                  __attribute__((used))
+    #define __RAMFUNC               __attribute__((section(".ramfunc"), noinline))  /*!< Function copied to and executed from RAM */
+    #define __NOINIT                __attribute__((section(".noinit")))             /*!< Variable left untouched by the startup code, kept across resets */
 #elif defined(__GNUC__)
     #define __ASM                   __asm                   /*!< asm keyword for GNU Compiler          */
     #define __INLINE                inline                  /*!< inline keyword for GNU Compiler       */
@@ -32,6 +46,8 @@
     #define __INTERRUPT             __attribute__((interrupt()))
     #define __WEAK                  __attribute__((weak))
     #define __USED                  __attribute__((used))
+    #define __RAMFUNC               __attribute__((section(".ramfunc"), noinline))  /*!< Function copied to and executed from RAM */
+    #define __NOINIT                __attribute__((section(".noinit")))             /*!< Variable left untouched by the startup code, kept across resets */
 #elif defined(__TASKING__)
     #define __ASM                   __asm                   /*!< asm keyword for TASKING Compiler      */
     #define __INLINE                inline                  /*!< inline keyword for TASKING Compiler   */
@@ -39,6 +55,8 @@
     #define __INTERRUPT             __attribute__((interrupt()))
     #define __WEAK                  __attribute__((weak))
     #define __USED                  __attribute__((used))
+    #define __RAMFUNC               __attribute__((section(".ramfunc"), noinline))  /*!< Function copied to and executed from RAM */
+    #define __NOINIT                __attribute__((section(".noinit")))             /*!< Variable left untouched by the startup code, kept across resets */
 #endif
 
 #endif /* __CONPILER_H */
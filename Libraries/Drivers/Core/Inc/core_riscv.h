@@ -64,6 +64,26 @@ typedef struct {
 
 #define SysTick                         ((SysTick_Type *) 0xE000F000UL)
 
+#ifdef HAL_SIMULATOR
+/* Host build, the CSRs and the wfi instruction are emulated by the simulator */
+uint32_t SIM_ReadCSR(const char *csr);
+void SIM_WriteCSR(const char *csr, uint32_t value);
+void SIM_WaitForInterrupt(void);
+#define __CSRR(csr, result)             ((result) = SIM_ReadCSR(#csr))
+#define __CSRW(csr, value)              SIM_WriteCSR(#csr, (value))
+#define __WFI_INSN()                    SIM_WaitForInterrupt()
+#define __NOP_INSN()                    ((void)0)
+#define __SP_READ(result)               ((result) = SIM_ReadCSR("sp"))
+#define __SP_WRITE(value)               SIM_WriteCSR("sp", (value))
+#else
+#define __CSRR(csr, result)             __ASM volatile("csrr %0, " #csr : "=r"(result))
+#define __CSRW(csr, value)              __ASM volatile("csrw " #csr ", %0" : : "r"(value))
+#define __WFI_INSN()                    __ASM volatile("wfi")
+#define __NOP_INSN()                    __ASM volatile("nop")
+#define __SP_READ(result)               __ASM volatile("mv %0, sp" : "=r"(result))
+#define __SP_WRITE(value)               __ASM volatile("mv sp, %0" : : "r"(value))
+#endif /* HAL_SIMULATOR */
+
 /******************************************************************************/
 /*                                System Timer                                */
 /******************************************************************************/
@@ -147,9 +167,9 @@ typedef struct {
  */
 __STATIC_FORCEINLINE void __enable_irq(void) {
     uint32_t result;
-    __asm volatile("csrr %0, mstatus" : "=r"(result));
+    __CSRR(mstatus, result);
     result |= 0x88U;
-    __asm volatile ("csrw mstatus, %0" : : "r" (result));
+    __CSRW(mstatus, result);
 }
 
 /**
@@ -158,9 +178,9 @@ __STATIC_FORCEINLINE void __enable_irq(void) {
  */
 __STATIC_FORCEINLINE void __disable_irq(void) {
     uint32_t result;
-    __asm volatile("csrr %0, mstatus" : "=r"(result));
+    __CSRR(mstatus, result);
     result &= ~0x88U;
-    __asm volatile ("csrw mstatus, %0" : : "r" (result));
+    __CSRW(mstatus, result);
 }
 
 /**
@@ -168,7 +188,7 @@ __STATIC_FORCEINLINE void __disable_irq(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __NOP(void) {
-    __asm volatile ("nop");
+    __NOP_INSN();
 }
 
 /**
@@ -256,7 +276,7 @@ __STATIC_FORCEINLINE void NVIC_SetPriority(IRQn_Type IRQn, uint8_t priority) {
 __STATIC_FORCEINLINE void __WFI(void) {
     /* wfi */
     NVIC->SCTLR &= ~(1UL << 3U);
-    asm volatile ("wfi");
+    __WFI_INSN();
 }
 
 /**
@@ -275,7 +295,7 @@ __STATIC_FORCEINLINE void _SEV(void) {
  */
 __STATIC_FORCEINLINE void _WFE(void) {
     NVIC->SCTLR |= (1UL << 3U);
-    asm volatile ("wfi");
+    __WFI_INSN();
 }
 
 /**
@@ -323,7 +343,7 @@ __STATIC_FORCEINLINE void NVIC_SystemReset(void) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MSTATUS(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mstatus" : "=r"(result));
+    __CSRR(mstatus, result);
     return (result);
 }
 
@@ -333,7 +353,7 @@ __STATIC_FORCEINLINE uint32_t __get_MSTATUS(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MSTATUS(uint32_t value) {
-    __ASM volatile("csrw mstatus, %0" : : "r"(value));
+    __CSRW(mstatus, value);
 }
 
 /**
@@ -342,7 +362,7 @@ __STATIC_FORCEINLINE void __set_MSTATUS(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MISA(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, misa" : "=r"(result));
+    __CSRR(misa, result);
     return (result);
 }
 
@@ -352,7 +372,7 @@ __STATIC_FORCEINLINE uint32_t __get_MISA(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MISA(uint32_t value) {
-    __ASM volatile("csrw misa, %0" : : "r"(value));
+    __CSRW(misa, value);
 }
 
 /**
@@ -361,7 +381,7 @@ __STATIC_FORCEINLINE void __set_MISA(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MTVEC(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mtvec" : "=r"(result));
+    __CSRR(mtvec, result);
     return (result);
 }
 
@@ -371,7 +391,7 @@ __STATIC_FORCEINLINE uint32_t __get_MTVEC(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MTVEC(uint32_t value) {
-    __ASM volatile("csrw mtvec, %0" : : "r"(value));
+    __CSRW(mtvec, value);
 }
 
 /**
@@ -380,7 +400,7 @@ __STATIC_FORCEINLINE void __set_MTVEC(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MSCRATCH(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mscratch" : "=r"(result));
+    __CSRR(mscratch, result);
     return (result);
 }
 
@@ -390,7 +410,7 @@ __STATIC_FORCEINLINE uint32_t __get_MSCRATCH(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MSCRATCH(uint32_t value) {
-    __ASM volatile("csrw mscratch, %0" : : "r"(value));
+    __CSRW(mscratch, value);
 }
 
 /**
@@ -399,7 +419,7 @@ __STATIC_FORCEINLINE void __set_MSCRATCH(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MEPC(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mepc" : "=r"(result));
+    __CSRR(mepc, result);
     return (result);
 }
 
@@ -408,7 +428,7 @@ __STATIC_FORCEINLINE uint32_t __get_MEPC(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MEPC(uint32_t value) {
-    __ASM volatile("csrw mepc, %0" : : "r"(value));
+    __CSRW(mepc, value);
 }
 
 /**
@@ -417,7 +437,7 @@ __STATIC_FORCEINLINE void __set_MEPC(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MCAUSE(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mcause" : "=r"(result));
+    __CSRR(mcause, result);
     return (result);
 }
 
@@ -426,7 +446,7 @@ __STATIC_FORCEINLINE uint32_t __get_MCAUSE(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_MCAUSE(uint32_t value) {
-    __ASM volatile("csrw mcause, %0" : : "r"(value));
+    __CSRW(mcause, value);
 }
 
 /**
@@ -435,7 +455,7 @@ __STATIC_FORCEINLINE void __set_MCAUSE(uint32_t value) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MVENDORID(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mvendorid" : "=r"(result));
+    __CSRR(mvendorid, result);
     return (result);
 }
 
@@ -445,7 +465,7 @@ __STATIC_FORCEINLINE uint32_t __get_MVENDORID(void) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MARCHID(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, marchid" : "=r"(result));
+    __CSRR(marchid, result);
     return (result);
 }
 
@@ -455,7 +475,7 @@ __STATIC_FORCEINLINE uint32_t __get_MARCHID(void) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MIMPID(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mimpid" : "=r"(result));
+    __CSRR(mimpid, result);
     return (result);
 }
 
@@ -465,7 +485,7 @@ __STATIC_FORCEINLINE uint32_t __get_MIMPID(void) {
  */
 __STATIC_FORCEINLINE uint32_t __get_MHARTID(void) {
     uint32_t result;
-    __ASM volatile("csrr %0, mhartid" : "=r"(result));
+    __CSRR(mhartid, result);
     return (result);
 }
 
@@ -475,7 +495,7 @@ __STATIC_FORCEINLINE uint32_t __get_MHARTID(void) {
  */
 __STATIC_FORCEINLINE uint32_t __get_SP(void) {
     uint32_t result;
-    __ASM volatile("mv %0, sp" : "=r"(result));
+    __SP_READ(result);
     return (result);
 }
 
@@ -485,7 +505,7 @@ __STATIC_FORCEINLINE uint32_t __get_SP(void) {
  * @return None.
  */
 __STATIC_FORCEINLINE void __set_SP(uint32_t value) {
-    __ASM volatile("mv sp, %0" : : "r"(value));
+    __SP_WRITE(value);
 }
 
 #ifdef __cplusplus
@@ -2683,6 +2683,11 @@ typedef enum IRQn {
 #define EXTEND_CTR_OPA_PSEL_Msk                 (0x01UL << EXTEND_CTR_OPA_PSEL_Pos)
 #define EXTEND_CTR_OPA_PSEL                     EXTEND_CTR_OPA_PSEL_Msk
 
+/* System startup (ch32v00x_system.c and the startup code) */
+void SystemInit(void);
+extern uint32_t SystemStartupCycles;           /* HCLK cycles from the end of SystemInit to main */
+extern uint32_t SystemCtorCycles;              /* Part of SystemStartupCycles spent in static constructors */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,57 @@
+
+#ifndef __BOOTDIAG_H
+#define __BOOTDIAG_H
+
+#include "ch32v00x_hal.h"
+
+typedef enum {
+    BOOTDIAG_RESET_UNKNOWN = 0U,
+    BOOTDIAG_RESET_POWER,                                       /*!< Power-on or power-down reset */
+    BOOTDIAG_RESET_PIN,                                         /*!< NRST pin */
+    BOOTDIAG_RESET_SOFTWARE,                                    /*!< Software reset, also used after a hard fault */
+    BOOTDIAG_RESET_IWDG,
+    BOOTDIAG_RESET_WWDG,
+    BOOTDIAG_RESET_LOWPOWER                                     /*!< Low-power management reset */
+} BOOTDIAG_ResetCauseTypeDef;
+
+/**
+ * @brief Crash record written by HardFault_Handler before resetting the MCU.
+ */
+typedef struct {
+    uint32_t Sp;                                                /*!< Stack pointer when the fault occurred */
+    uint32_t Mcause;
+    uint32_t Mepc;                                              /*!< Address of the faulting instruction */
+    uint32_t Magic;
+} BOOTDIAG_CrashTypeDef;
+
+typedef struct {
+    BOOTDIAG_ResetCauseTypeDef ResetCause;
+    uint32_t ResetFlags;                                        /*!< Raw RCC_RSTSCKR reset flags */
+    HAL_FlagStatusTypeDef BrownOut;                             /*!< PVD0 flag, VDD below the PVD threshold */
+    bool Crashed;                                               /*!< The last reset follows a hard fault, see Crash */
+    BOOTDIAG_CrashTypeDef Crash;
+} BOOTDIAG_InfoTypeDef;
+
+class BOOTDIAG_TypeDef {
+public:
+    void Init(void);
+    const BOOTDIAG_InfoTypeDef &GetInfo(void);
+private:
+    BOOTDIAG_TypeDef(void) = delete;
+    BOOTDIAG_TypeDef(const BOOTDIAG_TypeDef &) = delete;
+    void operator=(const BOOTDIAG_TypeDef &) = delete;
+};
+
+#define BOOTDIAG        (*(BOOTDIAG_TypeDef *)0U)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void HardFault_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOTDIAG_H */
@@ -0,0 +1,86 @@
+
+#include "bootdiag.h"
+
+#define BOOTDIAG_CRASH_MAGIC                    (0xC0A5DEADUL)
+#define BOOTDIAG_RESET_FLAGS                    (RCC_RSTSCKR_PINRSTF | RCC_RSTSCKR_PORRSTF | RCC_RSTSCKR_SFTRSTF |  \
+                                                 RCC_RSTSCKR_IWDGRSTF | RCC_RSTSCKR_WWDGRSTF | RCC_RSTSCKR_LPWRRSTF)
+
+extern "C" {
+__NOINIT BOOTDIAG_CrashTypeDef BOOTDIAG_Crash;
+}
+
+static BOOTDIAG_InfoTypeDef BOOTDIAG_Info;
+
+/**
+ * @brief  Capture the reset cause, the brown-out state and the crash record of the last reset.
+ * @note   The RCC reset flags are cleared, modules reading them (TASKWDG.Init) must be
+ *         initialized before. BrownOut is only meaningful when the PVD is enabled (PWR.SetPVD).
+ * @retval None.
+ */
+void BOOTDIAG_TypeDef::Init(void) {
+    uint32_t flags = RCC.REGS.RSTSCKR & BOOTDIAG_RESET_FLAGS;
+
+    BOOTDIAG_Info.ResetFlags = flags;
+    if(flags & RCC_RSTSCKR_LPWRRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_LOWPOWER;
+    else if(flags & RCC_RSTSCKR_WWDGRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_WWDG;
+    else if(flags & RCC_RSTSCKR_IWDGRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_IWDG;
+    else if(flags & RCC_RSTSCKR_SFTRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_SOFTWARE;
+    else if(flags & RCC_RSTSCKR_PORRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_POWER;
+    else if(flags & RCC_RSTSCKR_PINRSTF)
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_PIN;
+    else
+        BOOTDIAG_Info.ResetCause = BOOTDIAG_RESET_UNKNOWN;
+    RCC.REGS.RSTSCKR |= RCC_RSTSCKR_RMVF;
+
+    PWR.EnableClock();
+    BOOTDIAG_Info.BrownOut = PWR.GetPVD0();
+
+    /* The crash record is random after a power-on reset */
+    BOOTDIAG_Info.Crashed = (BOOTDIAG_Crash.Magic == BOOTDIAG_CRASH_MAGIC) && (flags & RCC_RSTSCKR_SFTRSTF) &&
+                            !(flags & RCC_RSTSCKR_PORRSTF);
+    BOOTDIAG_Info.Crash = BOOTDIAG_Crash;
+    BOOTDIAG_Crash.Magic = 0U;
+}
+
+/**
+ * @brief  Get the diagnostics captured by Init.
+ * @retval Boot diagnostics.
+ */
+const BOOTDIAG_InfoTypeDef &BOOTDIAG_TypeDef::GetInfo(void) {
+    return BOOTDIAG_Info;
+}
+
+/**
+ * @brief  Complete the crash record started by HardFault_Handler and reset the MCU.
+ * @retval None.
+ */
+extern "C" __attribute__((noreturn, used)) void BOOTDIAG_HardFault(void) {
+    uint32_t value;
+    __asm volatile("csrr %0, mcause" : "=r"(value));
+    BOOTDIAG_Crash.Mcause = value;
+    __asm volatile("csrr %0, mepc" : "=r"(value));
+    BOOTDIAG_Crash.Mepc = value;
+    BOOTDIAG_Crash.Magic = BOOTDIAG_CRASH_MAGIC;
+    NVIC_SystemReset();
+    while(1);
+}
+
+/**
+ * @brief  Hard fault handler, record the faulting context and reset the MCU.
+ * @note   The stack pointer is saved first and then moved back to the top of RAM,
+ *         so a fault caused by a stack overflow is also recorded.
+ * @retval None.
+ */
+__attribute__((naked)) void HardFault_Handler(void) {
+    __asm volatile(
+        "la t0, BOOTDIAG_Crash      \n"
+        "sw sp, 0(t0)               \n"
+        "la sp, _eusrstack          \n"
+        "j BOOTDIAG_HardFault       \n"
+    );
+}
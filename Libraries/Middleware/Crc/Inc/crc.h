@@ -0,0 +1,9 @@
+
+#ifndef __CRC_H
+#define __CRC_H
+
+#include "ch32v00x_hal.h"
+
+uint16_t CRC16_Calc(const void *data, uint32_t size, uint16_t crc = 0xFFFFU);
+
+#endif /* __CRC_H */
@@ -0,0 +1,24 @@
+
+#include "crc.h"
+
+/**
+ * @brief  Compute the CRC-16/CCITT (polynomial 0x1021) of a buffer.
+ * @param  data pointer to the data.
+ * @param  size size of data in bytes.
+ * @param  crc initial value, or the result of a previous call to continue the computation.
+ * @note   A 16-entry table is used to keep the code small without any multiplication.
+ * @retval CRC value.
+ */
+uint16_t CRC16_Calc(const void *data, uint32_t size, uint16_t crc) {
+    static const uint16_t CRC16_Table[16] = {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+    };
+    const uint8_t *buff = (const uint8_t *)data;
+    while(size--) {
+        crc = (uint16_t)(crc << 4U) ^ CRC16_Table[(crc >> 12U) ^ (*buff >> 4U)];
+        crc = (uint16_t)(crc << 4U) ^ CRC16_Table[(crc >> 12U) ^ (*buff & 0x0FU)];
+        buff++;
+    }
+    return crc;
+}
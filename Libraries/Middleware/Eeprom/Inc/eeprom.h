@@ -0,0 +1,38 @@
+
+#ifndef __EEPROM_H
+#define __EEPROM_H
+
+#include "ch32v00x_hal.h"
+
+#ifndef EEPROM_SECTOR_COUNT
+#define EEPROM_SECTOR_COUNT     (2U)            /*!< Number of 1KB flash sectors used by the EEPROM emulation */
+#endif /* EEPROM_SECTOR_COUNT */
+
+#ifndef EEPROM_MAX_KEYS
+#define EEPROM_MAX_KEYS         (14U)           /*!< Size of the RAM index, the keys and one spare record fit in a sector */
+#endif /* EEPROM_MAX_KEYS */
+
+#ifndef EEPROM_MAX_LENGTH
+#define EEPROM_MAX_LENGTH       (60U)           /*!< Maximum value length in bytes, a record fits in a 64B page */
+#endif /* EEPROM_MAX_LENGTH */
+
+#define EEPROM_SECTOR_SIZE      (0x400U)
+#define EEPROM_BASE             (FLASH_BASE + 0x4000U - EEPROM_SECTOR_COUNT * EEPROM_SECTOR_SIZE)
+
+class EEPROM_TypeDef {
+public:
+    HAL_StatusTypeDef Init(void);
+    HAL_StatusTypeDef Format(void);
+    HAL_StatusTypeDef Read(uint8_t key, void *data, uint32_t size);
+    HAL_StatusTypeDef Write(uint8_t key, const void *data, uint32_t size);
+    HAL_StatusTypeDef Erase(uint8_t key);
+    uint32_t GetLength(uint8_t key);
+private:
+    EEPROM_TypeDef(void) = delete;
+    EEPROM_TypeDef(const EEPROM_TypeDef &) = delete;
+    void operator=(const EEPROM_TypeDef &) = delete;
+};
+
+#define EEPROM          (*(EEPROM_TypeDef *)0U)
+
+#endif /* __EEPROM_H */
@@ -0,0 +1,302 @@
+
+#include "eeprom.h"
+#include "crc.h"
+
+#define EEPROM_MAGIC                            (0xEE50U)
+#define EEPROM_KEY_NONE                         (0xFFU)
+#define EEPROM_HEADER_SIZE                      (4U)
+#define EEPROM_RECORD_SIZE(length)              (EEPROM_HEADER_SIZE + (((length) + 3U) & ~3U))
+#define EEPROM_SECTOR_ADDR(sector)              (EEPROM_BASE + (sector) * EEPROM_SECTOR_SIZE)
+
+/* A transfer copies up to EEPROM_MAX_KEYS records, one more record must still fit to update a full store */
+static_assert(EEPROM_HEADER_SIZE + (EEPROM_MAX_KEYS + 1U) * EEPROM_RECORD_SIZE(EEPROM_MAX_LENGTH) <= EEPROM_SECTOR_SIZE,
+              "EEPROM_MAX_KEYS records of EEPROM_MAX_LENGTH bytes and a spare one must fit in a sector");
+
+typedef struct {
+    uint16_t Magic;
+    uint16_t Sequence;
+} EEPROM_SectorHeaderTypeDef;
+
+typedef struct {
+    uint8_t Key;
+    uint8_t Length;
+    uint16_t Crc;
+} EEPROM_RecordHeaderTypeDef;
+
+typedef struct {
+    uint8_t Key;
+    uint16_t Offset;
+} EEPROM_IndexTypeDef;
+
+static EEPROM_IndexTypeDef EEPROM_Index[EEPROM_MAX_KEYS];
+static uint32_t EEPROM_IndexCount = 0U;
+static uint32_t EEPROM_ActiveSector = 0U;
+static uint32_t EEPROM_WriteOffset = EEPROM_SECTOR_SIZE;
+static uint16_t EEPROM_Sequence = 0U;
+
+static uint16_t EEPROM_RecordCrc(const EEPROM_RecordHeaderTypeDef *header, const void *data) {
+    return CRC16_Calc(data, header->Length, CRC16_Calc(header, 2U));
+}
+
+static EEPROM_IndexTypeDef *EEPROM_Find(uint8_t key) {
+    for(uint32_t i = 0U; i < EEPROM_IndexCount; i++) {
+        if(EEPROM_Index[i].Key == key)
+            return &EEPROM_Index[i];
+    }
+    return NULL_PTR;
+}
+
+static bool EEPROM_IsBlank(uint32_t address) {
+    for(uint32_t i = 0U; i < EEPROM_SECTOR_SIZE; i += 4U) {
+        if(*(uint32_t *)(uintptr_t)(address + i) != 0xFFFFFFFFUL)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief  Rebuild the RAM index from the records of the active sector.
+ * @note   A record with a bad CRC (power lost while writing) is skipped. If its header
+ *         is not usable, the rest of the sector is considered full so that the next
+ *         write moves the valid records to a fresh sector.
+ * @retval None.
+ */
+static void EEPROM_Scan(void) {
+    uint32_t base = EEPROM_SECTOR_ADDR(EEPROM_ActiveSector);
+    uint32_t offset = EEPROM_HEADER_SIZE;
+
+    EEPROM_IndexCount = 0U;
+    while((offset + EEPROM_HEADER_SIZE) <= EEPROM_SECTOR_SIZE) {
+        EEPROM_RecordHeaderTypeDef *header = (EEPROM_RecordHeaderTypeDef *)(uintptr_t)(base + offset);
+        if(*(uint32_t *)header == 0xFFFFFFFFUL)
+            break;
+        if((header->Key == EEPROM_KEY_NONE) || (header->Length > EEPROM_MAX_LENGTH) ||
+           ((offset + EEPROM_RECORD_SIZE(header->Length)) > EEPROM_SECTOR_SIZE)) {
+            offset = EEPROM_SECTOR_SIZE;
+            break;
+        }
+        if(header->Crc == EEPROM_RecordCrc(header, header + 1)) {
+            EEPROM_IndexTypeDef *index = EEPROM_Find(header->Key);
+            if(header->Length == 0U) {
+                if(index != NULL_PTR)
+                    *index = EEPROM_Index[--EEPROM_IndexCount];
+            }
+            else if(index != NULL_PTR)
+                index->Offset = (uint16_t)offset;
+            else if(EEPROM_IndexCount < EEPROM_MAX_KEYS) {
+                EEPROM_Index[EEPROM_IndexCount].Key = header->Key;
+                EEPROM_Index[EEPROM_IndexCount].Offset = (uint16_t)offset;
+                EEPROM_IndexCount++;
+            }
+        }
+        offset += EEPROM_RECORD_SIZE(header->Length);
+    }
+    EEPROM_WriteOffset = offset;
+}
+
+/**
+ * @brief  Move the valid records of the active sector to the next sector.
+ * @note   The header of the new sector is written last, so an interrupted transfer
+ *         leaves the active sector untouched.
+ * @note   The size of the valid records is checked before anything is erased or written.
+ * @retval HAL status, HAL_ERROR if the valid records do not fit in a sector.
+ */
+static HAL_StatusTypeDef EEPROM_Transfer(void) {
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t next = (EEPROM_ActiveSector + 1U) % EEPROM_SECTOR_COUNT;
+    uint32_t src = EEPROM_SECTOR_ADDR(EEPROM_ActiveSector);
+    uint32_t dst = EEPROM_SECTOR_ADDR(next);
+    uint32_t offset = EEPROM_HEADER_SIZE;
+    EEPROM_SectorHeaderTypeDef header = {EEPROM_MAGIC, (uint16_t)(EEPROM_Sequence + 1U)};
+
+    for(uint32_t i = 0U; i < EEPROM_IndexCount; i++)
+        offset += EEPROM_RECORD_SIZE(((EEPROM_RecordHeaderTypeDef *)(uintptr_t)(src + EEPROM_Index[i].Offset))->Length);
+    if(offset > EEPROM_SECTOR_SIZE)
+        return HAL_ERROR;
+    offset = EEPROM_HEADER_SIZE;
+
+    if(!EEPROM_IsBlank(dst)) {
+        if((status = FLASH.ErasePage(dst, FLASH_ERASE_1KB)) != HAL_OK)
+            return status;
+    }
+    for(uint32_t i = 0U; i < EEPROM_IndexCount; i++) {
+        uint32_t size = EEPROM_RECORD_SIZE(((EEPROM_RecordHeaderTypeDef *)(uintptr_t)(src + EEPROM_Index[i].Offset))->Length);
+        if((status = FLASH.WriteData(dst + offset, (void *)(uintptr_t)(src + EEPROM_Index[i].Offset), size)) != HAL_OK)
+            break;
+        EEPROM_Index[i].Offset = (uint16_t)offset;
+        offset += size;
+    }
+    if((status != HAL_OK) || ((status = FLASH.WriteData(dst, &header, sizeof(header))) != HAL_OK)) {
+        EEPROM_Scan();
+        return status;
+    }
+
+    EEPROM_ActiveSector = next;
+    EEPROM_Sequence = header.Sequence;
+    EEPROM_WriteOffset = offset;
+    return FLASH.ErasePage(src, FLASH_ERASE_1KB);
+}
+
+/**
+ * @brief  Initializes the EEPROM emulation.
+ * @note   The sector with the most recent valid header is used, the others are erased.
+ *         If no sector is valid, the EEPROM is formatted.
+ * @note   The sectors must be kept out of the application image by building with
+ *         NVM_SIZE (FLASH_NVM_SIZE) covering them, HAL_ERROR is returned otherwise.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef EEPROM_TypeDef::Init(void) {
+    HAL_StatusTypeDef status = HAL_OK;
+    bool found = false;
+
+    if(EEPROM_BASE < FLASH_NVM_BASE)
+        return HAL_ERROR;
+
+    for(uint32_t i = 0U; i < EEPROM_SECTOR_COUNT; i++) {
+        EEPROM_SectorHeaderTypeDef *header = (EEPROM_SectorHeaderTypeDef *)EEPROM_SECTOR_ADDR(i);
+        if(header->Magic != EEPROM_MAGIC)
+            continue;
+        if((found == false) || ((int16_t)(header->Sequence - EEPROM_Sequence) > 0)) {
+            EEPROM_ActiveSector = i;
+            EEPROM_Sequence = header->Sequence;
+            found = true;
+        }
+    }
+    if(found == false)
+        return Format();
+
+    for(uint32_t i = 0U; i < EEPROM_SECTOR_COUNT; i++) {
+        if((i != EEPROM_ActiveSector) && (((EEPROM_SectorHeaderTypeDef *)EEPROM_SECTOR_ADDR(i))->Magic == EEPROM_MAGIC)) {
+            if((status = FLASH.ErasePage(EEPROM_SECTOR_ADDR(i), FLASH_ERASE_1KB)) != HAL_OK)
+                break;
+        }
+    }
+    EEPROM_Scan();
+    return status;
+}
+
+/**
+ * @brief  Erase all the sectors and clear all the keys.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef EEPROM_TypeDef::Format(void) {
+    HAL_StatusTypeDef status;
+    EEPROM_SectorHeaderTypeDef header = {EEPROM_MAGIC, 0U};
+
+    for(uint32_t i = 0U; i < EEPROM_SECTOR_COUNT; i++) {
+        if(!EEPROM_IsBlank(EEPROM_SECTOR_ADDR(i))) {
+            if((status = FLASH.ErasePage(EEPROM_SECTOR_ADDR(i), FLASH_ERASE_1KB)) != HAL_OK)
+                return status;
+        }
+    }
+    EEPROM_ActiveSector = 0U;
+    EEPROM_Sequence = 0U;
+    EEPROM_IndexCount = 0U;
+    EEPROM_WriteOffset = EEPROM_HEADER_SIZE;
+    return FLASH.WriteData(EEPROM_SECTOR_ADDR(0U), &header, sizeof(header));
+}
+
+/**
+ * @brief  Return the length of the value stored for a key.
+ * @param  key specifies the key (0 to 254).
+ * @retval Length of the value in bytes, 0 if the key does not exist.
+ */
+uint32_t EEPROM_TypeDef::GetLength(uint8_t key) {
+    EEPROM_IndexTypeDef *index = EEPROM_Find(key);
+    if(index == NULL_PTR)
+        return 0U;
+    return ((EEPROM_RecordHeaderTypeDef *)(EEPROM_SECTOR_ADDR(EEPROM_ActiveSector) + index->Offset))->Length;
+}
+
+/**
+ * @brief  Read the value of a key.
+ * @param  key specifies the key (0 to 254).
+ * @param  data pointer to the buffer receiving the value.
+ * @param  size size of the buffer, at most the length of the value is copied.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef EEPROM_TypeDef::Read(uint8_t key, void *data, uint32_t size) {
+    EEPROM_IndexTypeDef *index = EEPROM_Find(key);
+    if(index == NULL_PTR)
+        return HAL_ERROR;
+    EEPROM_RecordHeaderTypeDef *header = (EEPROM_RecordHeaderTypeDef *)(EEPROM_SECTOR_ADDR(EEPROM_ActiveSector) + index->Offset);
+    uint8_t *src = (uint8_t *)(header + 1);
+    uint8_t *dst = (uint8_t *)data;
+    if(size > header->Length)
+        size = header->Length;
+    while(size--)
+        *dst++ = *src++;
+    return HAL_OK;
+}
+
+/**
+ * @brief  Write the value of a key.
+ * @param  key specifies the key (0 to 254).
+ * @param  data pointer to the value.
+ * @param  size length of the value, it must not exceed EEPROM_MAX_LENGTH.
+ * @note   The record is appended to the active sector, no erase is needed until the
+ *         sector is full. Writing the same value again does not touch the flash.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef EEPROM_TypeDef::Write(uint8_t key, const void *data, uint32_t size) {
+    HAL_StatusTypeDef status;
+    uint32_t buff[EEPROM_RECORD_SIZE(EEPROM_MAX_LENGTH) / 4U];
+    EEPROM_RecordHeaderTypeDef *header = (EEPROM_RecordHeaderTypeDef *)buff;
+    EEPROM_IndexTypeDef *index = EEPROM_Find(key);
+    uint8_t *value = (uint8_t *)(header + 1);
+
+    if((key == EEPROM_KEY_NONE) || (size > EEPROM_MAX_LENGTH))
+        return HAL_ERROR;
+    if(index == NULL_PTR) {
+        if(size == 0U)
+            return HAL_OK;
+        if(EEPROM_IndexCount >= EEPROM_MAX_KEYS)
+            return HAL_ERROR;
+    }
+    else if(GetLength(key) == size) {
+        uint8_t *old = (uint8_t *)(EEPROM_SECTOR_ADDR(EEPROM_ActiveSector) + index->Offset + EEPROM_HEADER_SIZE);
+        uint32_t i = 0U;
+        while((i < size) && (old[i] == ((const uint8_t *)data)[i]))
+            i++;
+        if(i == size)
+            return HAL_OK;
+    }
+
+    header->Key = key;
+    header->Length = (uint8_t)size;
+    for(uint32_t i = 0U; i < EEPROM_RECORD_SIZE(size) - EEPROM_HEADER_SIZE; i++)
+        value[i] = (i < size) ? ((const uint8_t *)data)[i] : 0xFFU;
+    header->Crc = EEPROM_RecordCrc(header, value);
+
+    if((EEPROM_WriteOffset + EEPROM_RECORD_SIZE(size)) > EEPROM_SECTOR_SIZE) {
+        if((status = EEPROM_Transfer()) != HAL_OK)
+            return status;
+        if((EEPROM_WriteOffset + EEPROM_RECORD_SIZE(size)) > EEPROM_SECTOR_SIZE)
+            return HAL_ERROR;
+        index = EEPROM_Find(key);
+    }
+    status = FLASH.WriteData(EEPROM_SECTOR_ADDR(EEPROM_ActiveSector) + EEPROM_WriteOffset, buff, EEPROM_RECORD_SIZE(size));
+    if(status == HAL_OK) {
+        if(size == 0U)
+            *index = EEPROM_Index[--EEPROM_IndexCount];
+        else if(index != NULL_PTR)
+            index->Offset = (uint16_t)EEPROM_WriteOffset;
+        else {
+            EEPROM_Index[EEPROM_IndexCount].Key = key;
+            EEPROM_Index[EEPROM_IndexCount].Offset = (uint16_t)EEPROM_WriteOffset;
+            EEPROM_IndexCount++;
+        }
+    }
+    EEPROM_WriteOffset += EEPROM_RECORD_SIZE(size);
+    return status;
+}
+
+/**
+ * @brief  Remove a key.
+ * @param  key specifies the key (0 to 254).
+ * @note   An empty record is appended, the key is dropped at the next sector transfer.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef EEPROM_TypeDef::Erase(uint8_t key) {
+    return Write(key, NULL_PTR, 0U);
+}
@@ -0,0 +1,44 @@
+
+#ifndef __FLASHLOG_H
+#define __FLASHLOG_H
+
+#include "ch32v00x_hal.h"
+#include "eeprom.h"
+
+#ifndef FLASHLOG_SIZE
+#define FLASHLOG_SIZE           (0x800U)        /*!< Size of the log area, a multiple of 64B */
+#endif /* FLASHLOG_SIZE */
+
+#ifndef FLASHLOG_BASE
+#define FLASHLOG_BASE           (EEPROM_BASE - FLASHLOG_SIZE)           /*!< Just below the EEPROM emulation sectors */
+#endif /* FLASHLOG_BASE */
+
+#define FLASHLOG_RECORD_SIZE    (64U)
+#define FLASHLOG_RECORD_COUNT   (FLASHLOG_SIZE / FLASHLOG_RECORD_SIZE)
+#define FLASHLOG_DATA_SIZE      (FLASHLOG_RECORD_SIZE - 8U)
+
+typedef struct {
+    uint32_t Sequence;
+    uint16_t Length;
+    uint16_t Crc;
+    uint8_t Data[FLASHLOG_DATA_SIZE];
+} FLASHLOG_RecordTypeDef;
+
+class FLASHLOG_TypeDef {
+public:
+    HAL_StatusTypeDef Init(void);
+    HAL_StatusTypeDef Clear(void);
+    HAL_StatusTypeDef Append(const void *data, uint32_t size);
+    HAL_StatusTypeDef Process(void);
+    uint32_t GetCount(void);
+    const FLASHLOG_RecordTypeDef *GetRecord(uint32_t index);
+    HAL_StatusTypeDef Dump(USART_TypeDef &usart, uint32_t timeout = 0xFFFFFFFFUL);
+private:
+    FLASHLOG_TypeDef(void) = delete;
+    FLASHLOG_TypeDef(const FLASHLOG_TypeDef &) = delete;
+    void operator=(const FLASHLOG_TypeDef &) = delete;
+};
+
+#define FLASHLOG        (*(FLASHLOG_TypeDef *)0U)
+
+#endif /* __FLASHLOG_H */
@@ -0,0 +1,205 @@
+
+#include "flashlog.h"
+#include "crc.h"
+
+#define FLASHLOG_SLOT(index)                    ((FLASHLOG_RecordTypeDef *)(FLASHLOG_BASE + (index) * FLASHLOG_RECORD_SIZE))
+#define FLASHLOG_SEQUENCE_NONE                  (0xFFFFFFFFUL)
+
+static uint32_t FLASHLOG_WriteIndex = 0U;
+static uint32_t FLASHLOG_Sequence = 0U;
+
+static uint16_t FLASHLOG_RecordCrc(const FLASHLOG_RecordTypeDef *record) {
+    return CRC16_Calc(record->Data, record->Length, CRC16_Calc(record, 6U));
+}
+
+static bool FLASHLOG_IsValid(const FLASHLOG_RecordTypeDef *record) {
+    return (record->Sequence != FLASHLOG_SEQUENCE_NONE) && (record->Length <= FLASHLOG_DATA_SIZE) &&
+           (record->Crc == FLASHLOG_RecordCrc(record));
+}
+
+static bool FLASHLOG_IsBlank(const FLASHLOG_RecordTypeDef *record) {
+    for(uint32_t i = 0U; i < (FLASHLOG_RECORD_SIZE / 4U); i++) {
+        if(((const uint32_t *)record)[i] != 0xFFFFFFFFUL)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief  Wait for the end of an asynchronous FLASH operation started by Process.
+ * @note   The busy flag is checked with interrupts masked before each sleep, so the EOP
+ *         interrupt cannot fire between the check and the wfi: it stays pending, wakes the
+ *         core up and is taken when interrupts are unmasked again (see HAL.Sleep).
+ *         The caller must not run with interrupts masked, the operation ends in the interrupt.
+ * @retval None.
+ */
+static void FLASHLOG_WaitFlash(void) {
+    uint32_t state = __get_MSTATUS();
+    __set_MSTATUS(state & ~0x08U);
+    while(FLASH.IsBusy()) {
+        HAL.Sleep(0U);
+        __set_MSTATUS(state);
+        __set_MSTATUS(state & ~0x08U);
+    }
+    __set_MSTATUS(state);
+}
+
+/**
+ * @brief  Initializes the log and find the head.
+ * @note   Records are written in order, so the slots from 0 up to the head hold the
+ *         sequence numbers of slot 0 plus their index. The head is the last slot
+ *         matching this rule, found by binary search in O(log n) flash reads.
+ * @note   The log must be kept out of the application image by building with NVM_SIZE
+ *         (FLASH_NVM_SIZE) covering it, HAL_ERROR is returned otherwise.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASHLOG_TypeDef::Init(void) {
+    if(FLASHLOG_BASE < FLASH_NVM_BASE)
+        return HAL_ERROR;
+    if(FLASHLOG_IsValid(FLASHLOG_SLOT(0U))) {
+        uint32_t first = FLASHLOG_SLOT(0U)->Sequence;
+        uint32_t low = 0U;
+        uint32_t high = FLASHLOG_RECORD_COUNT - 1U;
+        while(low < high) {
+            uint32_t mid = (low + high + 1U) >> 1U;
+            if(FLASHLOG_SLOT(mid)->Sequence == (first + mid))
+                low = mid;
+            else
+                high = mid - 1U;
+        }
+        FLASHLOG_Sequence = FLASHLOG_SLOT(low)->Sequence + 1U;
+        FLASHLOG_WriteIndex = (low + 1U) % FLASHLOG_RECORD_COUNT;
+    }
+    else if(FLASHLOG_SLOT(FLASHLOG_RECORD_COUNT - 1U)->Sequence != FLASHLOG_SEQUENCE_NONE) {
+        /* Slot 0 was being erased or written after a wrap */
+        FLASHLOG_Sequence = FLASHLOG_SLOT(FLASHLOG_RECORD_COUNT - 1U)->Sequence + 1U;
+        FLASHLOG_WriteIndex = 0U;
+    }
+    else {
+        FLASHLOG_Sequence = 0U;
+        FLASHLOG_WriteIndex = 0U;
+    }
+    if(FLASHLOG_Sequence == FLASHLOG_SEQUENCE_NONE)
+        FLASHLOG_Sequence = 0U;
+    return HAL_OK;
+}
+
+/**
+ * @brief  Erase the whole log.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASHLOG_TypeDef::Clear(void) {
+    HAL_StatusTypeDef status = HAL_OK;
+    for(uint32_t i = 0U; i < FLASHLOG_RECORD_COUNT; i++) {
+        if(!FLASHLOG_IsBlank(FLASHLOG_SLOT(i))) {
+            if((status = FLASH.ErasePage(HAL_ADDRESS(FLASHLOG_SLOT(i)), FLASH_ERASE_64B)) != HAL_OK)
+                break;
+        }
+    }
+    FLASHLOG_Sequence = 0U;
+    FLASHLOG_WriteIndex = 0U;
+    return status;
+}
+
+/**
+ * @brief  Append a record to the log.
+ * @param  data pointer to the record data.
+ * @param  size size of data, it must not exceed FLASHLOG_DATA_SIZE.
+ * @note   The oldest record is overwritten when the log is full. An erase started by
+ *         Process is waited for. If the slot has not been erased in advance, it is erased
+ *         here and the CPU is held for the whole erase.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASHLOG_TypeDef::Append(const void *data, uint32_t size) {
+    HAL_StatusTypeDef status;
+    FLASHLOG_RecordTypeDef record;
+    FLASHLOG_RecordTypeDef *slot = FLASHLOG_SLOT(FLASHLOG_WriteIndex);
+
+    if(size > FLASHLOG_DATA_SIZE)
+        return HAL_ERROR;
+    FLASHLOG_WaitFlash();
+    if(!FLASHLOG_IsBlank(slot)) {
+        if((status = FLASH.ErasePage(HAL_ADDRESS(slot), FLASH_ERASE_64B)) != HAL_OK)
+            return status;
+    }
+
+    record.Sequence = FLASHLOG_Sequence;
+    record.Length = (uint16_t)size;
+    for(uint32_t i = 0U; i < FLASHLOG_DATA_SIZE; i++)
+        record.Data[i] = (i < size) ? ((const uint8_t *)data)[i] : 0xFFU;
+    record.Crc = FLASHLOG_RecordCrc(&record);
+
+    status = FLASH.WriteData(HAL_ADDRESS(slot), &record, sizeof(record));
+    FLASHLOG_Sequence = (FLASHLOG_Sequence + 1U != FLASHLOG_SEQUENCE_NONE) ? (FLASHLOG_Sequence + 1U) : 0U;
+    FLASHLOG_WriteIndex = (FLASHLOG_WriteIndex + 1U) % FLASHLOG_RECORD_COUNT;
+    return status;
+}
+
+/**
+ * @brief  Erase the next slot in advance, in the background.
+ * @note   This function should be called from the main loop between two appends so that
+ *         Append only needs the 64B fast program. The erase is started with
+ *         FLASH.ErasePageAsync and ends in the FLASH interrupt. Instructions fetched from
+ *         FLASH stall until then, so only code running from RAM keeps running meanwhile.
+ * @retval HAL status, HAL_BUSY while a FLASH operation is in progress.
+ */
+HAL_StatusTypeDef FLASHLOG_TypeDef::Process(void) {
+    if(FLASH.IsBusy())
+        return HAL_BUSY;
+    FLASHLOG_RecordTypeDef *slot = FLASHLOG_SLOT(FLASHLOG_WriteIndex);
+    if(FLASHLOG_IsBlank(slot))
+        return HAL_OK;
+    return FLASH.ErasePageAsync(HAL_ADDRESS(slot), FLASH_ERASE_64B);
+}
+
+/**
+ * @brief  Return the number of valid records in the log.
+ * @retval Number of records.
+ */
+uint32_t FLASHLOG_TypeDef::GetCount(void) {
+    uint32_t count = 0U;
+    for(uint32_t i = 0U; i < FLASHLOG_RECORD_COUNT; i++) {
+        if(FLASHLOG_IsValid(FLASHLOG_SLOT(i)))
+            count++;
+    }
+    return count;
+}
+
+/**
+ * @brief  Return a record of the log.
+ * @param  index index of the record, 0 is the oldest one.
+ * @retval Pointer to the record in flash, NULL_PTR if index is out of range.
+ */
+const FLASHLOG_RecordTypeDef *FLASHLOG_TypeDef::GetRecord(uint32_t index) {
+    uint32_t slot = FLASHLOG_WriteIndex;
+    for(uint32_t i = 0U; i < FLASHLOG_RECORD_COUNT; i++) {
+        if(FLASHLOG_IsValid(FLASHLOG_SLOT(slot))) {
+            if(index == 0U)
+                return FLASHLOG_SLOT(slot);
+            index--;
+        }
+        slot = (slot + 1U) % FLASHLOG_RECORD_COUNT;
+    }
+    return NULL_PTR;
+}
+
+/**
+ * @brief  Stream all the valid records from the oldest to the newest over USART.
+ * @param  usart USART used for the read-out, it must be configured in 8-bit mode.
+ * @param  timeout timeout duration for each record.
+ * @note   Each record is sent as its raw 64 bytes, the host checks the CRC and orders
+ *         the records by sequence number.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef FLASHLOG_TypeDef::Dump(USART_TypeDef &usart, uint32_t timeout) {
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t slot = FLASHLOG_WriteIndex;
+    for(uint32_t i = 0U; i < FLASHLOG_RECORD_COUNT; i++) {
+        if(FLASHLOG_IsValid(FLASHLOG_SLOT(slot))) {
+            if((status = usart.Transmit((uint8_t *)FLASHLOG_SLOT(slot), FLASHLOG_RECORD_SIZE, timeout)) != HAL_OK)
+                break;
+        }
+        slot = (slot + 1U) % FLASHLOG_RECORD_COUNT;
+    }
+    return status;
+}
@@ -0,0 +1,52 @@
+
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#include "ch32v00x_hal.h"
+
+#ifndef SCHED_QUEUE_SIZE
+#define SCHED_QUEUE_SIZE        (8U)            /*!< Pending events per priority level, a power of 2 */
+#endif /* SCHED_QUEUE_SIZE */
+
+#ifndef SCHED_MAX_TIMERS
+#define SCHED_MAX_TIMERS        (4U)            /*!< Number of software timers */
+#endif /* SCHED_MAX_TIMERS */
+
+#define SCHED_TIMER_NONE        (0xFFU)         /*!< No timer */
+
+typedef enum {
+    SCHED_PRIORITY_HIGH = 0U,
+    SCHED_PRIORITY_NORMAL = 1U,
+    SCHED_PRIORITY_LOW = 2U
+} SCHED_PriorityTypeDef;
+
+#define SCHED_PRIORITY_COUNT    (3U)
+
+/**
+ * @brief Event handler, run to completion from the scheduler loop (never from an
+ *        interrupt handler). param is the value given to Post, or the timer ID.
+ */
+typedef void (*SCHED_HandlerTypeDef)(uint32_t param);
+
+class SCHED_TypeDef {
+public:
+    void Init(void);
+    HAL_StatusTypeDef Post(SCHED_HandlerTypeDef handler, uint32_t param = 0U, SCHED_PriorityTypeDef priority = SCHED_PRIORITY_NORMAL);
+    HAL_StatusTypeDef StartTimer(SCHED_HandlerTypeDef handler, uint32_t delayMs, uint32_t periodMs = 0U,
+                                 SCHED_PriorityTypeDef priority = SCHED_PRIORITY_NORMAL, uint8_t *id = NULL_PTR);
+    void StopTimer(uint8_t id);
+    bool RunOnce(void);
+    __attribute__((noreturn)) void Run(void);
+    uint32_t GetDropped(void);
+    EXTI_CallbackTypeDef EXTIEvent(uint32_t line, SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority = SCHED_PRIORITY_HIGH);
+    FLASH_CallbackTypeDef FLASHEvent(SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority = SCHED_PRIORITY_NORMAL);
+    WWDG_CallbackTypeDef WWDGEvent(SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority = SCHED_PRIORITY_HIGH);
+private:
+    SCHED_TypeDef(void) = delete;
+    SCHED_TypeDef(const SCHED_TypeDef &) = delete;
+    void operator=(const SCHED_TypeDef &) = delete;
+};
+
+#define SCHED                   (*(SCHED_TypeDef *)0U)
+
+#endif /* __SCHED_H */
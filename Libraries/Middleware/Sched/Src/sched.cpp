@@ -0,0 +1,301 @@
+
+#include "sched.h"
+
+#define SCHED_INDEX_MASK        (SCHED_QUEUE_SIZE - 1U)
+#define SCHED_EXTI_LINES        (8U)            /* Lines served by EXTI7_0_IRQHandler */
+
+static_assert((SCHED_QUEUE_SIZE & SCHED_INDEX_MASK) == 0U, "SCHED_QUEUE_SIZE must be a power of 2");
+static_assert(SCHED_MAX_TIMERS < SCHED_TIMER_NONE, "Too many scheduler timers");
+
+typedef struct {
+    SCHED_HandlerTypeDef volatile Handler[SCHED_QUEUE_SIZE];
+    volatile uint32_t Param[SCHED_QUEUE_SIZE];
+    volatile uint32_t Head;                     /* Events posted, free running */
+    volatile uint32_t Tail;                     /* Events run, free running */
+} SCHED_QueueTypeDef;
+
+typedef struct {
+    SCHED_HandlerTypeDef Handler;               /* NULL_PTR when the timer is stopped */
+    uint32_t Due;                               /* SysTick tick of the next expiry */
+    uint32_t Period;                            /* Reload in ticks, 0 for a one-shot timer */
+    SCHED_PriorityTypeDef Priority;
+} SCHED_TimerTypeDef;
+
+static SCHED_QueueTypeDef SCHED_Queues[SCHED_PRIORITY_COUNT];
+static SCHED_TimerTypeDef SCHED_Timers[SCHED_MAX_TIMERS];
+static volatile uint32_t SCHED_Dropped = 0U;
+
+typedef struct {
+    SCHED_HandlerTypeDef Handler;
+    SCHED_PriorityTypeDef Priority;
+} SCHED_EventTypeDef;
+
+static SCHED_EventTypeDef SCHED_ExtiEvents[SCHED_EXTI_LINES];
+static SCHED_EventTypeDef SCHED_FlashEvent;
+static SCHED_EventTypeDef SCHED_WwdgEvent;
+
+__STATIC_FORCEINLINE uint32_t SCHED_Lock(void) {
+    uint32_t state = __get_MSTATUS();
+    __set_MSTATUS(state & ~0x08U);
+    return state;
+}
+
+__STATIC_FORCEINLINE void SCHED_Unlock(uint32_t state) {
+    if(state & 0x08U)
+        __set_MSTATUS(__get_MSTATUS() | 0x08U);
+}
+
+/**
+ * @brief  EXTI callback returned by EXTIEvent, posts the event of the line with the
+ *         EXTI_LINE_x value as parameter.
+ * @param  line EXTI_LINE_x value of the line that triggered.
+ * @retval None.
+ */
+static __RAMFUNC void SCHED_ExtiCallback(uint32_t line) {
+    const SCHED_EventTypeDef &event = SCHED_ExtiEvents[__builtin_ctz(line)];
+    SCHED.Post(event.Handler, line, event.Priority);
+}
+
+/**
+ * @brief  FLASH callback returned by FLASHEvent, posts the event with the status of
+ *         the operation as parameter.
+ * @param  status status of the asynchronous operation.
+ * @note   Called from FLASH_IRQHandler while the flash can still be busy, so it runs from RAM.
+ * @retval None.
+ */
+static __RAMFUNC void SCHED_FlashCallback(HAL_StatusTypeDef status) {
+    SCHED.Post(SCHED_FlashEvent.Handler, (uint32_t)status, SCHED_FlashEvent.Priority);
+}
+
+/**
+ * @brief  WWDG callback returned by WWDGEvent, posts the event.
+ * @retval None.
+ */
+static void SCHED_WwdgCallback(void) {
+    SCHED.Post(SCHED_WwdgEvent.Handler, 0U, SCHED_WwdgEvent.Priority);
+}
+
+/**
+ * @brief  Post the expired timers and compute the time to the next expiry.
+ * @retval Number of ticks until the next timer expires, 0 if no timer is running.
+ */
+static uint32_t SCHED_ProcessTimers(void) {
+    uint32_t wait = 0U;
+    for(uint32_t i = 0U; i < SCHED_MAX_TIMERS; i++) {
+        SCHED_TimerTypeDef &timer = SCHED_Timers[i];
+        if(timer.Handler == NULL_PTR)
+            continue;
+        uint32_t tick = SysTick->CNT;
+        if((int32_t)(tick - timer.Due) >= 0) {
+            SCHED.Post(timer.Handler, i, timer.Priority);
+            if(timer.Period == 0U) {
+                timer.Handler = NULL_PTR;
+                continue;
+            }
+            timer.Due += timer.Period;
+            if((int32_t)(tick - timer.Due) >= 0)
+                timer.Due = tick + timer.Period;
+        }
+        uint32_t remaining = timer.Due - tick;
+        if((wait == 0U) || (remaining < wait))
+            wait = remaining;
+    }
+    return wait;
+}
+
+/**
+ * @brief  Clear the event queues and stop all the timers.
+ * @retval None.
+ */
+void SCHED_TypeDef::Init(void) {
+    uint32_t state = SCHED_Lock();
+    for(uint32_t i = 0U; i < SCHED_PRIORITY_COUNT; i++) {
+        SCHED_Queues[i].Head = 0U;
+        SCHED_Queues[i].Tail = 0U;
+    }
+    for(uint32_t i = 0U; i < SCHED_MAX_TIMERS; i++)
+        SCHED_Timers[i].Handler = NULL_PTR;
+    SCHED_Dropped = 0U;
+    SCHED_Unlock(state);
+}
+
+/**
+ * @brief  Queue an event, its handler will be run from the scheduler loop.
+ * @param  handler function to be run.
+ * @param  param value passed to the handler.
+ * @param  priority queue of the event. Pending events of a higher priority always run first,
+ *         events of the same priority run in the order they were posted.
+ * @note   Safe from interrupt handlers and from the main loop. Interrupts are masked
+ *         only while the slot is reserved, the RV32EC core has no atomic instructions.
+ * @retval HAL status, HAL_BUSY if the queue is full and the event is dropped.
+ */
+__RAMFUNC HAL_StatusTypeDef SCHED_TypeDef::Post(SCHED_HandlerTypeDef handler, uint32_t param, SCHED_PriorityTypeDef priority) {
+    if((handler == NULL_PTR) || (priority >= SCHED_PRIORITY_COUNT))
+        return HAL_ERROR;
+    SCHED_QueueTypeDef &queue = SCHED_Queues[priority];
+    uint32_t state = SCHED_Lock();
+    uint32_t head = queue.Head;
+    if((head - queue.Tail) >= SCHED_QUEUE_SIZE) {
+        SCHED_Dropped++;
+        SCHED_Unlock(state);
+        return HAL_BUSY;
+    }
+    queue.Handler[head & SCHED_INDEX_MASK] = handler;
+    queue.Param[head & SCHED_INDEX_MASK] = param;
+    queue.Head = head + 1U;
+    SCHED_Unlock(state);
+    return HAL_OK;
+}
+
+/**
+ * @brief  Start a software timer posting an event when it expires.
+ * @param  handler function to be run, it receives the timer ID as parameter.
+ * @param  delayMs time (in ms) before the first expiry.
+ * @param  periodMs reload time (in ms), 0 for a one-shot timer.
+ * @param  priority queue of the event posted at each expiry.
+ * @param  id optional pointer to the timer ID, to be passed to StopTimer.
+ * @note   Timers run from the free-running SysTick counter, no tick interrupt is needed.
+ *         Delays are limited to half the SysTick wrap period.
+ *         This function must not be called from an interrupt handler.
+ * @retval HAL status, HAL_BUSY if all the timers are in use.
+ */
+HAL_StatusTypeDef SCHED_TypeDef::StartTimer(SCHED_HandlerTypeDef handler, uint32_t delayMs, uint32_t periodMs,
+                                            SCHED_PriorityTypeDef priority, uint8_t *id) {
+    uint32_t limit = HAL.TicksToMs(0x7FFFFFFFUL);
+    if((handler == NULL_PTR) || (priority >= SCHED_PRIORITY_COUNT) || (delayMs > limit) || (periodMs > limit))
+        return HAL_ERROR;
+    for(uint32_t i = 0U; i < SCHED_MAX_TIMERS; i++) {
+        SCHED_TimerTypeDef &timer = SCHED_Timers[i];
+        if(timer.Handler != NULL_PTR)
+            continue;
+        timer.Due = SysTick->CNT + HAL.MsToTicks(delayMs);
+        timer.Period = HAL.MsToTicks(periodMs);
+        timer.Priority = priority;
+        timer.Handler = handler;
+        if(id != NULL_PTR)
+            *id = (uint8_t)i;
+        return HAL_OK;
+    }
+    return HAL_BUSY;
+}
+
+/**
+ * @brief  Stop a software timer.
+ * @param  id timer ID returned by StartTimer.
+ * @note   An event already posted by the timer still runs.
+ * @retval None.
+ */
+void SCHED_TypeDef::StopTimer(uint8_t id) {
+    if(id < SCHED_MAX_TIMERS)
+        SCHED_Timers[id].Handler = NULL_PTR;
+}
+
+/**
+ * @brief  Run the oldest pending event of the highest priority.
+ * @note   The handler runs to completion before this function returns. It can be
+ *         used to drain the queues from a custom main loop.
+ * @retval true if an event was run, false if all the queues are empty.
+ */
+bool SCHED_TypeDef::RunOnce(void) {
+    for(uint32_t i = 0U; i < SCHED_PRIORITY_COUNT; i++) {
+        SCHED_QueueTypeDef &queue = SCHED_Queues[i];
+        uint32_t tail = queue.Tail;
+        if(queue.Head != tail) {
+            SCHED_HandlerTypeDef handler = queue.Handler[tail & SCHED_INDEX_MASK];
+            uint32_t param = queue.Param[tail & SCHED_INDEX_MASK];
+            queue.Tail = tail + 1U;
+            handler(param);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief  Scheduler loop, never returns.
+ * @note   Events run one at a time, the highest priority first. When all the queues are
+ *         empty the core sleeps until the next timer expiry or an interrupt, the queues
+ *         being checked with interrupts masked so that an event posted meanwhile always
+ *         wakes it up. No periodic tick interrupt is needed, but drivers relying on it
+ *         (EXTI debounce) still work: with the tick interrupt enabled, the sleep is
+ *         bounded by the tick instead of the timer expiry.
+ * @retval None.
+ */
+void SCHED_TypeDef::Run(void) {
+    while(1U) {
+        uint32_t wait = SCHED_ProcessTimers();
+        if(RunOnce())
+            continue;
+        uint32_t state = SCHED_Lock();
+        bool idle = true;
+        for(uint32_t i = 0U; i < SCHED_PRIORITY_COUNT; i++) {
+            if(SCHED_Queues[i].Head != SCHED_Queues[i].Tail)
+                idle = false;
+        }
+        if(idle)
+            HAL.Sleep(wait);
+        SCHED_Unlock(state);
+    }
+}
+
+/**
+ * @brief  Return the number of events dropped because their queue was full.
+ * @retval Number of dropped events since Init.
+ */
+uint32_t SCHED_TypeDef::GetDropped(void) {
+    return SCHED_Dropped;
+}
+
+/**
+ * @brief  Get an EXTI callback posting an event instead of running from the interrupt.
+ * @param  line Specifies the lines posting the event.
+ *         This parameter can be any combination of EXTI_LINE_x where x can be (0..7).
+ * @param  handler function to be run, it receives the EXTI_LINE_x value of the line.
+ * @param  priority queue of the event.
+ * @note   The callback is to be passed to EXTI.SetCallback for the same lines, e.g.
+ *         EXTI.SetCallback(EXTI_LINE_2, SCHED.EXTIEvent(EXTI_LINE_2, OnButton), 20U).
+ *         A debounced line is released from the SysTick interrupt: SetCallback enables the
+ *         periodic tick (1ms unless EnabelTickIRQ was called before), so Run then wakes up
+ *         on every tick. Without debounce, the scheduler stays tickless.
+ * @retval Callback to be registered, NULL_PTR if handler is NULL_PTR.
+ */
+EXTI_CallbackTypeDef SCHED_TypeDef::EXTIEvent(uint32_t line, SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority) {
+    line &= (1UL << SCHED_EXTI_LINES) - 1U;
+    for(uint32_t mask = line; mask; mask &= mask - 1U) {
+        SCHED_EventTypeDef &event = SCHED_ExtiEvents[__builtin_ctz(mask)];
+        event.Handler = handler;
+        event.Priority = priority;
+    }
+    return (handler != NULL_PTR) ? SCHED_ExtiCallback : NULL_PTR;
+}
+
+/**
+ * @brief  Get a FLASH callback posting an event when an asynchronous operation completes.
+ * @param  handler function to be run, it receives the HAL status of the operation.
+ * @param  priority queue of the event.
+ * @note   The callback is to be passed to FLASH.WriteDataAsync or FLASH.ErasePageAsync,
+ *         e.g. FLASH.WriteDataAsync(address, data, size, SCHED.FLASHEvent(OnWritten)).
+ *         A single asynchronous operation runs at a time, so a single event is kept.
+ * @retval Callback to be registered, NULL_PTR if handler is NULL_PTR.
+ */
+FLASH_CallbackTypeDef SCHED_TypeDef::FLASHEvent(SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority) {
+    SCHED_FlashEvent.Handler = handler;
+    SCHED_FlashEvent.Priority = priority;
+    return (handler != NULL_PTR) ? SCHED_FlashCallback : NULL_PTR;
+}
+
+/**
+ * @brief  Get a WWDG callback posting an event on the early wakeup interrupt.
+ * @param  handler function to be run, its parameter is 0.
+ * @param  priority queue of the event.
+ * @note   The callback is to be passed to WWDG.Init, e.g. WWDG.Init(config, SCHED.WWDGEvent(OnWwdg)).
+ *         The reset occurs one WWDG clock period after the interrupt, the handler only
+ *         runs in time if no other event is running and should keep to a short action
+ *         such as saving a diagnostic record.
+ * @retval Callback to be registered, NULL_PTR if handler is NULL_PTR.
+ */
+WWDG_CallbackTypeDef SCHED_TypeDef::WWDGEvent(SCHED_HandlerTypeDef handler, SCHED_PriorityTypeDef priority) {
+    SCHED_WwdgEvent.Handler = handler;
+    SCHED_WwdgEvent.Priority = priority;
+    return (handler != NULL_PTR) ? SCHED_WwdgCallback : NULL_PTR;
+}
@@ -0,0 +1,43 @@
+
+#ifndef __STACKMON_H
+#define __STACKMON_H
+
+#include "ch32v00x_hal.h"
+
+#ifndef STACKMON_PATTERN
+#define STACKMON_PATTERN        (0xA5A5A5A5UL)  /*!< Must match STACK_PAINT_PATTERN of the startup code */
+#endif /* STACKMON_PATTERN */
+
+#ifndef STACKMON_MARGIN
+#define STACKMON_MARGIN         (64U)           /*!< Free bytes under which the fault hook is called */
+#endif /* STACKMON_MARGIN */
+
+typedef enum {
+    STACKMON_FAULT_BUDGET = 0U,                 /*!< The stack grew beyond __stack_size of the linker script */
+    STACKMON_FAULT_MARGIN = 1U                  /*!< Less than STACKMON_MARGIN bytes between the stack and .bss or the heap */
+} STACKMON_FaultTypeDef;
+
+typedef void (*STACKMON_HookTypeDef)(STACKMON_FaultTypeDef fault, uint32_t freeBytes);
+
+/**
+ * @brief Stack and RAM monitor. The free RAM between the end of .bss and the top of
+ *        the stack is painted with STACKMON_PATTERN by the startup code when it is
+ *        built with STACK_PAINT=1, the deepest stack use is the lowest word which
+ *        no longer holds the pattern.
+ */
+class STACKMON_TypeDef {
+public:
+    void Init(STACKMON_HookTypeDef hook);
+    uint32_t GetStackUsed(void);
+    uint32_t GetStackSize(void);
+    uint32_t GetFreeGap(void);
+    HAL_StatusTypeDef Process(void);
+private:
+    STACKMON_TypeDef(void) = delete;
+    STACKMON_TypeDef(const STACKMON_TypeDef &) = delete;
+    void operator=(const STACKMON_TypeDef &) = delete;
+};
+
+#define STACKMON        (*(STACKMON_TypeDef *)0U)
+
+#endif /* __STACKMON_H */
@@ -0,0 +1,105 @@
+
+#include <stddef.h>
+#include "stackmon.h"
+
+extern "C" {
+extern uint32_t _ebss[];
+extern uint32_t _susrstack[];
+extern uint32_t _eusrstack[];
+/* Only linked when the application uses the heap */
+void *_sbrk(ptrdiff_t increment) __attribute__((weak));
+}
+
+static STACKMON_HookTypeDef STACKMON_Hook = NULL_PTR;
+static uint32_t *STACKMON_Deepest = _eusrstack;
+static uint8_t STACKMON_Reported = 0U;
+
+/**
+ * @brief  Get the lowest address the stack may grow to without corrupting data.
+ * @retval Top of the heap, or end of .bss when the heap is not used.
+ */
+static uint32_t *STACKMON_GetFloor(void) {
+    uint32_t *floor = _ebss;
+    if(_sbrk != NULL_PTR) {
+        uint32_t *brk = (uint32_t *)(((uint32_t)_sbrk(0) + 3U) & ~3U);
+        if(brk > floor)
+            floor = brk;
+    }
+    return floor;
+}
+
+/**
+ * @brief  Find the deepest word written by the stack.
+ * @note   Scans the painted area upwards from its floor, so the duration depends on the
+ *         free RAM, about 4 cycles per free word.
+ * @retval Lowest address used by the stack.
+ */
+static uint32_t *STACKMON_Scan(void) {
+    uint32_t *word = STACKMON_GetFloor();
+    while((word < STACKMON_Deepest) && (*word == STACKMON_PATTERN))
+        word++;
+    STACKMON_Deepest = word;
+    return word;
+}
+
+/**
+ * @brief  Set the function called by Process when the stack is about to overflow.
+ * @param  hook fault hook, called once per fault kind. It may log the fault and
+ *         reset the device. It can be a null pointer.
+ * @retval None.
+ */
+void STACKMON_TypeDef::Init(STACKMON_HookTypeDef hook) {
+    STACKMON_Hook = hook;
+    STACKMON_Reported = 0U;
+}
+
+/**
+ * @brief  Get the stack high-water mark.
+ * @retval Maximum number of bytes used by the stack since reset.
+ */
+uint32_t STACKMON_TypeDef::GetStackUsed(void) {
+    return (uint32_t)_eusrstack - (uint32_t)STACKMON_Scan();
+}
+
+/**
+ * @brief  Get the stack size reserved by the linker script (__stack_size).
+ * @retval Stack size in bytes.
+ */
+uint32_t STACKMON_TypeDef::GetStackSize(void) {
+    return (uint32_t)_eusrstack - (uint32_t)_susrstack;
+}
+
+/**
+ * @brief  Get the free RAM left between .bss or the heap and the deepest stack use.
+ * @retval Number of free bytes.
+ */
+uint32_t STACKMON_TypeDef::GetFreeGap(void) {
+    uint32_t *deepest = STACKMON_Scan();
+    uint32_t *floor = STACKMON_GetFloor();
+    return (deepest > floor) ? ((uint32_t)deepest - (uint32_t)floor) : 0U;
+}
+
+/**
+ * @brief  Check the stack usage, to be called periodically.
+ * @note   The fault hook is called when the stack went beyond the space reserved by
+ *         the linker script, and when less than STACKMON_MARGIN bytes are left before
+ *         it overwrites .bss or the heap.
+ * @retval HAL_ERROR if one of these faults has occurred, HAL_OK otherwise.
+ */
+HAL_StatusTypeDef STACKMON_TypeDef::Process(void) {
+    uint32_t free = GetFreeGap();
+    HAL_StatusTypeDef status = HAL_OK;
+    if(STACKMON_Deepest < _susrstack) {
+        if(!(STACKMON_Reported & (1U << STACKMON_FAULT_BUDGET)) && (STACKMON_Hook != NULL_PTR))
+            STACKMON_Hook(STACKMON_FAULT_BUDGET, free);
+        STACKMON_Reported |= 1U << STACKMON_FAULT_BUDGET;
+        status = HAL_ERROR;
+    }
+    if(free < STACKMON_MARGIN) {
+        if(!(STACKMON_Reported & (1U << STACKMON_FAULT_MARGIN)) && (STACKMON_Hook != NULL_PTR))
+            STACKMON_Hook(STACKMON_FAULT_MARGIN, free);
+        STACKMON_Reported |= 1U << STACKMON_FAULT_MARGIN;
+        status = HAL_ERROR;
+    }
+    return status;
+}
@@ -0,0 +1,60 @@
+
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include "ch32v00x_hal.h"
+
+/**
+ * @brief Profiling zone, declared with PROFILE_ZONE as a static object.
+ *        All zones are grouped by the linker in one RAM table.
+ * @note  Times are in SysTick ticks, HCLK/8 by default or HCLK cycles
+ *        after HAL.SetTickClock(HAL_TICKCLK_HCLK).
+ */
+class ProfileZone {
+public:
+    constexpr ProfileZone(const char *name) :
+        name(name), count(0U), minTicks(0xFFFFFFFFUL), maxTicks(0U), totalTicks(0U), selfTicks(0U) {
+    }
+    void Reset(void);
+    static void ResetAll(void);
+    static HAL_StatusTypeDef Dump(USART_TypeDef &usart, uint32_t timeout = 0xFFFFFFFFUL);
+public:
+    const char *name;
+    uint32_t count;
+    uint32_t minTicks;
+    uint32_t maxTicks;
+    uint32_t totalTicks;                        /*!< Time spent in the zone, nested zones included */
+    uint32_t selfTicks;                         /*!< Time spent in the zone, nested zones excluded */
+};
+
+/**
+ * @brief Scope guard measuring the time until it goes out of scope.
+ * @note  Scopes may be nested, including from interrupt handlers.
+ */
+class ProfileScope {
+public:
+    ProfileScope(ProfileZone &zone);
+    ~ProfileScope(void);
+private:
+    ProfileZone &zone;
+    ProfileScope *parent;
+    uint32_t startTick;
+    uint32_t childTicks;
+    ProfileScope(const ProfileScope &) = delete;
+    void operator=(const ProfileScope &) = delete;
+};
+
+#ifdef HAL_SIMULATOR
+/* Host linker, the zone bounds are the __start_ and __stop_ symbols it generates */
+#define PROFILE_ZONE_SECTION                    "profile_zones"
+#else
+#define PROFILE_ZONE_SECTION                    ".profile_zones"
+#endif /* HAL_SIMULATOR */
+
+#define PROFILE_ZONE(zone, name)                __USED __attribute__((section(PROFILE_ZONE_SECTION))) ProfileZone zone(name)
+
+#define PROFILE_CONCAT_(a, b)                   a##b
+#define PROFILE_CONCAT(a, b)                    PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(zone)                     ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+
+#endif /* __PROFILER_H */
@@ -0,0 +1,112 @@
+
+#include "profiler.h"
+
+#ifdef HAL_SIMULATOR
+/* Host linker, the bounds are only defined when a zone exists */
+#define __profile_zones_start                   __start_profile_zones
+#define __profile_zones_end                     __stop_profile_zones
+extern ProfileZone __profile_zones_start[] __attribute__((weak));
+extern ProfileZone __profile_zones_end[] __attribute__((weak));
+#else
+extern ProfileZone __profile_zones_start[];
+extern ProfileZone __profile_zones_end[];
+#endif /* HAL_SIMULATOR */
+
+static ProfileScope *currentScope = NULL_PTR;
+
+/**
+ * @brief  Clear the statistics of the zone.
+ * @retval None.
+ */
+void ProfileZone::Reset(void) {
+    count = 0U;
+    minTicks = 0xFFFFFFFFUL;
+    maxTicks = 0U;
+    totalTicks = 0U;
+    selfTicks = 0U;
+}
+
+/**
+ * @brief  Clear the statistics of all the zones.
+ * @retval None.
+ */
+void ProfileZone::ResetAll(void) {
+    for(ProfileZone *zone = __profile_zones_start; zone < __profile_zones_end; zone++)
+        zone->Reset();
+}
+
+static uint32_t ProfileFormat(char *buff, uint32_t value, uint32_t width) {
+    char digits[10];
+    uint32_t length = 0U;
+    uint32_t index = 0U;
+    do {
+        digits[length++] = '0' + (value % 10U);
+        value /= 10U;
+    } while(value);
+    while(width-- > length)
+        buff[index++] = ' ';
+    while(length)
+        buff[index++] = digits[--length];
+    return index;
+}
+
+/**
+ * @brief  Send the statistics of all the zones as a text table.
+ * @param  usart USART used to send the table, its transmit mode must be enabled.
+ * @param  timeout timeout duration for each line.
+ * @note   One line per zone: name, count, min, max, total and self ticks.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef ProfileZone::Dump(USART_TypeDef &usart, uint32_t timeout) {
+    static const char header[] = "zone                count        min        max      total       self\r\n";
+    char line[80];
+    HAL_StatusTypeDef status = usart.Transmit((uint8_t *)header, sizeof(header) - 1U, timeout);
+    for(ProfileZone *zone = __profile_zones_start; (zone < __profile_zones_end) && (status == HAL_OK); zone++) {
+        uint32_t length = 0U;
+        for(const char *name = zone->name; *name && (length < 14U); name++)
+            line[length++] = *name;
+        while(length < 14U)
+            line[length++] = ' ';
+        length += ProfileFormat(&line[length], zone->count, 11U);
+        length += ProfileFormat(&line[length], zone->count ? zone->minTicks : 0U, 11U);
+        length += ProfileFormat(&line[length], zone->maxTicks, 11U);
+        length += ProfileFormat(&line[length], zone->totalTicks, 11U);
+        length += ProfileFormat(&line[length], zone->selfTicks, 11U);
+        line[length++] = '\r';
+        line[length++] = '\n';
+        status = usart.Transmit((uint8_t *)line, length, timeout);
+    }
+    return status;
+}
+
+/**
+ * @brief  Constructor of profile scope, start measuring the zone.
+ * @param  zone zone to be measured.
+ * @retval None.
+ */
+ProfileScope::ProfileScope(ProfileZone &zone) : zone(zone) {
+    parent = currentScope;
+    currentScope = this;
+    childTicks = 0U;
+    startTick = SysTick->CNT;
+}
+
+/**
+ * @brief  Destructor of profile scope, add the measured time to the zone.
+ * @note   The time is also reported to the enclosing scope, so it is not
+ *         counted in the self time of the enclosing zone.
+ * @retval None.
+ */
+ProfileScope::~ProfileScope(void) {
+    uint32_t ticks = SysTick->CNT - startTick;
+    zone.count++;
+    zone.totalTicks += ticks;
+    zone.selfTicks += ticks - childTicks;
+    if(ticks < zone.minTicks)
+        zone.minTicks = ticks;
+    if(ticks > zone.maxTicks)
+        zone.maxTicks = ticks;
+    if(parent != NULL_PTR)
+        parent->childTicks += ticks;
+    currentScope = parent;
+}
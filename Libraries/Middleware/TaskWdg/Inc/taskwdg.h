@@ -0,0 +1,28 @@
+
+#ifndef __TASKWDG_H
+#define __TASKWDG_H
+
+#include "ch32v00x_hal.h"
+
+#ifndef TASKWDG_MAX_TASKS
+#define TASKWDG_MAX_TASKS       (8U)            /*!< Maximum number of supervised tasks */
+#endif /* TASKWDG_MAX_TASKS */
+
+#define TASKWDG_NONE            (0xFFU)         /*!< No task, returned when the last reset was not caused by a task */
+
+class TASKWDG_TypeDef {
+public:
+    HAL_StatusTypeDef Init(uint32_t timeoutMs);
+    HAL_StatusTypeDef Register(uint32_t deadlineMs, uint8_t *id);
+    void CheckIn(uint8_t id);
+    void Process(void);
+    uint8_t GetResetCulprit(void);
+private:
+    TASKWDG_TypeDef(void) = delete;
+    TASKWDG_TypeDef(const TASKWDG_TypeDef &) = delete;
+    void operator=(const TASKWDG_TypeDef &) = delete;
+};
+
+#define TASKWDG         (*(TASKWDG_TypeDef *)0U)
+
+#endif /* __TASKWDG_H */
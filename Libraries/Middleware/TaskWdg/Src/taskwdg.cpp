@@ -0,0 +1,117 @@
+
+#include "taskwdg.h"
+
+#define TASKWDG_LSI_KHZ                         (128U)
+#define TASKWDG_RECORD_MAGIC                    (0x7A5C0000UL)
+#define TASKWDG_RECORD_MASK                     (0xFFFF0000UL)
+
+static __NOINIT uint32_t TASKWDG_Record;
+static uint8_t TASKWDG_Culprit = TASKWDG_NONE;
+static uint8_t TASKWDG_Count = 0U;
+static bool TASKWDG_Expired = false;
+static uint32_t TASKWDG_Deadline[TASKWDG_MAX_TASKS];                /* In SysTick ticks */
+static volatile uint32_t TASKWDG_LastCheckIn[TASKWDG_MAX_TASKS];    /* SysTick->CNT of the last check-in */
+static volatile uint8_t TASKWDG_CheckedIn[TASKWDG_MAX_TASKS];
+
+/**
+ * @brief  Read the culprit of the last reset and start the IWDG.
+ * @param  timeoutMs IWDG timeout (in ms), up to 8190ms. It must be longer than the
+ *         period Process is called with.
+ * @note   The culprit is only reported if the last reset was caused by the IWDG,
+ *         the RCC reset flags are not cleared.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef TASKWDG_TypeDef::Init(uint32_t timeoutMs) {
+    uint32_t reload = (timeoutMs * TASKWDG_LSI_KHZ) / 4U;
+    uint32_t div = IWDG_DIV_4;
+
+    if((timeoutMs == 0U) || (timeoutMs > ((0xFFFU * 256U) / TASKWDG_LSI_KHZ)))
+        return HAL_ERROR;
+    while(reload > 0xFFFU) {
+        reload >>= 1U;
+        div++;
+    }
+
+    TASKWDG_Culprit = TASKWDG_NONE;
+    if(((TASKWDG_Record & TASKWDG_RECORD_MASK) == TASKWDG_RECORD_MAGIC) && (RCC.REGS.RSTSCKR & RCC_RSTSCKR_IWDGRSTF))
+        TASKWDG_Culprit = (uint8_t)TASKWDG_Record;
+    TASKWDG_Record = 0U;
+    TASKWDG_Count = 0U;
+    TASKWDG_Expired = false;
+
+    IWDG.SetPrescaler((IWDG_DivTypeDef)div);
+    IWDG.SetReload(reload);
+    IWDG.Reset();
+    IWDG.Start();
+    return HAL_OK;
+}
+
+/**
+ * @brief  Register a task to be supervised.
+ * @param  deadlineMs maximum time (in ms) between two check-ins of the task.
+ * @param  id pointer to the task ID, to be passed to CheckIn.
+ * @note   Check-ins are time stamped with the raw SysTick counter, so the deadline is
+ *         limited to half the SysTick wrap period.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef TASKWDG_TypeDef::Register(uint32_t deadlineMs, uint8_t *id) {
+    if((TASKWDG_Count >= TASKWDG_MAX_TASKS) || (deadlineMs > HAL.TicksToMs(0x7FFFFFFFUL)))
+        return HAL_ERROR;
+    TASKWDG_Deadline[TASKWDG_Count] = HAL.MsToTicks(deadlineMs);
+    TASKWDG_LastCheckIn[TASKWDG_Count] = SysTick->CNT;
+    TASKWDG_CheckedIn[TASKWDG_Count] = 0U;
+    *id = TASKWDG_Count++;
+    return HAL_OK;
+}
+
+/**
+ * @brief  Signal that a task is alive.
+ * @param  id task ID returned by Register.
+ * @note   This function can be called from an interrupt handler.
+ * @retval None.
+ */
+void TASKWDG_TypeDef::CheckIn(uint8_t id) {
+    if(id >= TASKWDG_Count)
+        return;
+    TASKWDG_LastCheckIn[id] = SysTick->CNT;
+    TASKWDG_CheckedIn[id] = 1U;
+}
+
+/**
+ * @brief  Refresh the IWDG once every task has checked in.
+ * @note   This function must be called periodically, typically from the main loop.
+ *         When a task misses its deadline, its ID is recorded for GetResetCulprit
+ *         and the IWDG is no longer refreshed until it resets the MCU.
+ * @retval None.
+ */
+void TASKWDG_TypeDef::Process(void) {
+    uint32_t tick = SysTick->CNT;
+    bool all = (TASKWDG_Count != 0U);
+
+    if(TASKWDG_Expired)
+        return;
+    for(uint8_t i = 0U; i < TASKWDG_Count; i++) {
+        if(TASKWDG_CheckedIn[i])
+            continue;
+        all = false;
+        /* Signed difference: a check-in from an interrupt after tick was read is not late */
+        if((int32_t)(tick - TASKWDG_LastCheckIn[i] - TASKWDG_Deadline[i]) > 0) {
+            TASKWDG_Record = TASKWDG_RECORD_MAGIC | i;
+            TASKWDG_Expired = true;
+            return;
+        }
+    }
+    if(all) {
+        IWDG.Reset();
+        for(uint8_t i = 0U; i < TASKWDG_Count; i++)
+            TASKWDG_CheckedIn[i] = 0U;
+    }
+}
+
+/**
+ * @brief  Get the task that caused the last reset.
+ * @retval ID of the task which missed its deadline, TASKWDG_NONE if the last reset had another cause.
+ */
+uint8_t TASKWDG_TypeDef::GetResetCulprit(void) {
+    return TASKWDG_Culprit;
+}
@@ -0,0 +1,64 @@
+
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include "ch32v00x_hal.h"
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            (1U)            /*!< 0 compiles the TRACE_ macros out */
+#endif /* TRACE_ENABLE */
+
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE       (64U)           /*!< Number of records in RAM, a power of 2 */
+#endif /* TRACE_BUFFER_SIZE */
+
+#define TRACE_DMA_CHANNEL       DMA1.CHANNEL4   /*!< USART1_TX request */
+
+/* Bits 7:6 of the event byte give the kind of the record, bits 5:0 the application event id */
+#define TRACE_KIND_INSTANT      (0x00U)
+#define TRACE_KIND_BEGIN        (0x40U)
+#define TRACE_KIND_END          (0x80U)
+#define TRACE_KIND_SYSTEM       (0xC0U)
+#define TRACE_EVENT_MASK        (0x3FU)
+
+#define TRACE_EVENT_START       (0xFDU)         /*!< Arg is TRACE_START_MAGIC, delta is the number of ticks per ms */
+#define TRACE_EVENT_DROP        (0xFEU)         /*!< Arg is the number of records lost, saturated to 255 */
+#define TRACE_EVENT_TIME        (0xFFU)         /*!< Delta is bits 31:16 of the delta of the next record */
+#define TRACE_START_MAGIC       (0xA5U)
+
+/**
+ * @brief Trace record, sent as 4 bytes in this order.
+ */
+typedef struct {
+    uint8_t Event;
+    uint8_t Arg;
+    uint16_t Delta;                             /*!< SysTick ticks since the previous record */
+} TRACE_RecordTypeDef;
+
+class TRACE_TypeDef {
+public:
+    HAL_StatusTypeDef Init(void);
+    void Write(uint8_t event, uint8_t arg);
+    HAL_StatusTypeDef Process(void);
+    HAL_StatusTypeDef Flush(uint32_t timeout = 0xFFFFFFFFUL);
+    uint32_t GetDropped(void);
+    void DeInit(void);
+private:
+    TRACE_TypeDef(void) = delete;
+    TRACE_TypeDef(const TRACE_TypeDef &) = delete;
+    void operator=(const TRACE_TypeDef &) = delete;
+};
+
+#define TRACE                   (*(TRACE_TypeDef *)0U)
+
+#if (TRACE_ENABLE)
+#define TRACE_EVENT(id, arg)    TRACE.Write(TRACE_KIND_INSTANT | ((id) & TRACE_EVENT_MASK), (uint8_t)(arg))
+#define TRACE_BEGIN(id, arg)    TRACE.Write(TRACE_KIND_BEGIN | ((id) & TRACE_EVENT_MASK), (uint8_t)(arg))
+#define TRACE_END(id, arg)      TRACE.Write(TRACE_KIND_END | ((id) & TRACE_EVENT_MASK), (uint8_t)(arg))
+#else
+#define TRACE_EVENT(id, arg)    ((void)0)
+#define TRACE_BEGIN(id, arg)    ((void)0)
+#define TRACE_END(id, arg)      ((void)0)
+#endif /* TRACE_ENABLE */
+
+#endif /* __TRACE_H */
@@ -0,0 +1,145 @@
+
+#include "trace.h"
+
+#define TRACE_INDEX_MASK        (TRACE_BUFFER_SIZE - 1U)
+#define TRACE_RECORD(event, arg, delta)         ((uint32_t)(event) | ((uint32_t)(arg) << 8U) | ((uint32_t)(delta) << 16U))
+
+static_assert((TRACE_BUFFER_SIZE & TRACE_INDEX_MASK) == 0U, "TRACE_BUFFER_SIZE must be a power of 2");
+static_assert(sizeof(TRACE_RecordTypeDef) == sizeof(uint32_t), "Trace records must be packed in 4 bytes");
+
+static uint32_t TRACE_Buffer[TRACE_BUFFER_SIZE];
+static volatile uint32_t TRACE_Head = 0U;       /* Records written, free running */
+static volatile uint32_t TRACE_Tail = 0U;       /* Records sent, free running */
+static uint32_t TRACE_Sending = 0U;
+static uint32_t TRACE_LastTick = 0U;
+static uint32_t TRACE_Dropped = 0U;
+static uint32_t TRACE_DroppedTotal = 0U;
+
+__STATIC_FORCEINLINE uint32_t TRACE_Lock(void) {
+    uint32_t state;
+    __ASM volatile("csrrci %0, mstatus, 0x08" : "=r"(state) : : "memory");
+    return state;
+}
+
+__STATIC_FORCEINLINE void TRACE_Unlock(uint32_t state) {
+    if(state & 0x08U)
+        __ASM volatile("csrsi mstatus, 0x08" : : : "memory");
+}
+
+/**
+ * @brief  Initializes the trace buffer and the DMA channel draining it to USART1.
+ * @note   USART1 must be initialized with its transmit mode enabled. A start record
+ *         holding the tick rate is queued first so the decoder can align the stream.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef TRACE_TypeDef::Init(void) {
+    uint32_t ticksPerMs = HAL.MsToTicks(1U);
+    if(!(USART1.REGS.CTLR1 & USART_CTLR1_TE))
+        return HAL_ERROR;
+    DMA1.EnableClock();
+    TRACE_DMA_CHANNEL.DeInit();
+    TRACE_DMA_CHANNEL.REGS.CFGR = DMA_CFGR_DIR | DMA_CFGR_MINC;
+    TRACE_DMA_CHANNEL.REGS.PADDR = (uint32_t)&USART1.REGS.DATAR;
+    USART1.REGS.CTLR3 |= USART_CTLR3_DMAT;
+
+    uint32_t state = TRACE_Lock();
+    TRACE_Buffer[0] = TRACE_RECORD(TRACE_EVENT_START, TRACE_START_MAGIC, (ticksPerMs > 0xFFFFU) ? 0xFFFFU : ticksPerMs);
+    TRACE_Head = 1U;
+    TRACE_Tail = 0U;
+    TRACE_Sending = 0U;
+    TRACE_Dropped = 0U;
+    TRACE_DroppedTotal = 0U;
+    TRACE_LastTick = SysTick->CNT;
+    TRACE_Unlock(state);
+    return HAL_OK;
+}
+
+/**
+ * @brief  Append a record to the trace buffer.
+ * @param  event event byte, see TRACE_KIND_xxx.
+ * @param  arg 8 bits argument of the event.
+ * @note   Safe from interrupt handlers and from the main loop. Interrupts are masked
+ *         only for the few instructions reserving the slot, the RV32EC core has no
+ *         atomic instructions. The record is dropped if the buffer is full.
+ * @retval None.
+ */
+__RAMFUNC void TRACE_TypeDef::Write(uint8_t event, uint8_t arg) {
+    uint32_t state = TRACE_Lock();
+    uint32_t tick = SysTick->CNT;
+    uint32_t delta = tick - TRACE_LastTick;
+    uint32_t head = TRACE_Head;
+    uint32_t count = 1U + ((delta >> 16U) ? 1U : 0U) + (TRACE_Dropped ? 1U : 0U);
+    if((head - TRACE_Tail + count) > TRACE_BUFFER_SIZE) {
+        TRACE_Dropped++;
+        TRACE_DroppedTotal++;
+    }
+    else {
+        if(TRACE_Dropped) {
+            TRACE_Buffer[head++ & TRACE_INDEX_MASK] = TRACE_RECORD(TRACE_EVENT_DROP, (TRACE_Dropped > 0xFFU) ? 0xFFU : TRACE_Dropped, 0U);
+            TRACE_Dropped = 0U;
+        }
+        if(delta >> 16U)
+            TRACE_Buffer[head++ & TRACE_INDEX_MASK] = TRACE_RECORD(TRACE_EVENT_TIME, 0U, delta >> 16U);
+        TRACE_Buffer[head++ & TRACE_INDEX_MASK] = TRACE_RECORD(event, arg, delta & 0xFFFFU);
+        TRACE_Head = head;
+        TRACE_LastTick = tick;
+    }
+    TRACE_Unlock(state);
+}
+
+/**
+ * @brief  Send the pending records, to be called periodically from the main loop.
+ * @note   Never blocks: when the previous DMA transfer is complete, its records are
+ *         released and the next contiguous block of the buffer is handed to the DMA.
+ * @retval HAL_BUSY while a transfer is ongoing, HAL_OK otherwise.
+ */
+HAL_StatusTypeDef TRACE_TypeDef::Process(void) {
+    if(TRACE_DMA_CHANNEL.GetStatus() != HAL_OK)
+        return HAL_BUSY;
+    uint32_t tail = TRACE_Tail + TRACE_Sending;
+    uint32_t index = tail & TRACE_INDEX_MASK;
+    uint32_t count = TRACE_Head - tail;
+    TRACE_Tail = tail;
+    if(count > (TRACE_BUFFER_SIZE - index))
+        count = TRACE_BUFFER_SIZE - index;
+    TRACE_Sending = count;
+    if(count) {
+        TRACE_DMA_CHANNEL.Stop();
+        TRACE_DMA_CHANNEL.REGS.MADDR = (uint32_t)&TRACE_Buffer[index];
+        TRACE_DMA_CHANNEL.REGS.CNTR = count * sizeof(TRACE_RecordTypeDef);
+        TRACE_DMA_CHANNEL.REGS.CFGR |= DMA_CFGR_EN;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  Send all the pending records in blocking mode.
+ * @param  timeout timeout duration.
+ * @retval HAL status.
+ */
+HAL_StatusTypeDef TRACE_TypeDef::Flush(uint32_t timeout) {
+    uint32_t startTick = HAL.GetTickMs();
+    while((Process() != HAL_OK) || (TRACE_Sending != 0U)) {
+        if((HAL.GetTickMs() - startTick) >= timeout)
+            return HAL_TIMEOUT;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief  Get the number of records lost because the buffer was full.
+ * @retval Number of dropped records since Init.
+ */
+uint32_t TRACE_TypeDef::GetDropped(void) {
+    return TRACE_DroppedTotal;
+}
+
+/**
+ * @brief  Stop the drain and release the DMA channel.
+ * @retval None.
+ */
+void TRACE_TypeDef::DeInit(void) {
+    TRACE_DMA_CHANNEL.DeInit();
+    USART1.REGS.CTLR3 &= ~USART_CTLR3_DMAT;
+    TRACE_Sending = 0U;
+}
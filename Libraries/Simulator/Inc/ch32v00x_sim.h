@@ -0,0 +1,69 @@
+
+#ifndef __CH32V00x_SIM_H
+#define __CH32V00x_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SIM_ACCESS_CYCLES
+#define SIM_ACCESS_CYCLES           (4U)            /*!< HCLK cycles charged to each peripheral register access */
+#endif /* SIM_ACCESS_CYCLES */
+
+#ifndef SIM_FLASH_ERASE_CYCLES
+#define SIM_FLASH_ERASE_CYCLES      (96000U)        /*!< Page erase duration, 2ms at 48MHz */
+#endif /* SIM_FLASH_ERASE_CYCLES */
+
+#ifndef SIM_FLASH_PROGRAM_CYCLES
+#define SIM_FLASH_PROGRAM_CYCLES    (9600U)         /*!< Page program duration, 200us at 48MHz */
+#endif /* SIM_FLASH_PROGRAM_CYCLES */
+
+#ifndef SIM_ADC_CONVERSION_CYCLES
+#define SIM_ADC_CONVERSION_CYCLES   (28U)           /*!< 3 sample and 11 conversion cycles at HCLK/2 */
+#endif /* SIM_ADC_CONVERSION_CYCLES */
+
+#ifndef SIM_WFI_TIMEOUT_CYCLES
+#define SIM_WFI_TIMEOUT_CYCLES      (48000000U)     /*!< Maximum sleep of a wfi with no interrupt to wake it up */
+#endif /* SIM_WFI_TIMEOUT_CYCLES */
+
+#ifndef SIM_STACK_SIZE
+#define SIM_STACK_SIZE              (0x100000U)     /*!< Stack of the application, below 4GB like all its data */
+#endif /* SIM_STACK_SIZE */
+
+#define SIM_EXIT_RESET              (3)             /*!< Exit code of the simulator on a software reset */
+
+/**
+ * @brief Called for each SPI frame sent by the master, returns the frame received.
+ *        Without responder the SPI is looped back (MISO connected to MOSI).
+ */
+typedef uint16_t (*SIM_SPIResponderTypeDef)(uint16_t mosi);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Test and benchmark API */
+uint64_t SIM_GetCycles(void);
+void SIM_Advance(uint32_t cycles);
+void SIM_USART_Inject(const uint8_t *data, uint32_t length);
+uint32_t SIM_USART_Fetch(uint8_t *data, uint32_t length);
+void SIM_USART_SetEcho(bool enabled);
+void SIM_SPI_SetResponder(SIM_SPIResponderTypeDef responder);
+void SIM_ADC_SetInput(uint32_t channel, uint16_t value);
+
+/* Used between the simulator core and the peripheral models */
+uint8_t *SIM_Shadow(uintptr_t address);
+void SIM_SetPendingIRQ(uint32_t irq);
+void SIM_SetIRQLine(uint32_t irq, bool asserted);
+uint32_t SIM_BusRead(uint32_t address, uint32_t size);
+void SIM_BusWrite(uint32_t address, uint32_t size, uint32_t value);
+void SIM_PeriphReset(void);
+void SIM_PeriphRead(uintptr_t address);
+void SIM_PeriphReadDone(uintptr_t address);
+void SIM_PeriphWrite(uintptr_t address, uint32_t old);
+void SIM_PeriphStep(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CH32V00x_SIM_H */
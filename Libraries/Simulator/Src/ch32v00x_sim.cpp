@@ -0,0 +1,542 @@
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "ch32v00x_hal.h"
+#include "ch32v00x_sim.h"
+
+#if !defined(__linux__) || !(defined(__x86_64__) || defined(__i386__))
+#error "The simulator traps the register accesses with the x86 Linux signals"
+#endif
+
+/* The application main is renamed by the simulator build (-Dmain=SIM_AppMain) */
+#undef main
+int SIM_AppMain(void);
+
+#define SIM_EFLAGS_TF                           (0x100U)
+#define SIM_PAGE_FAULT_WRITE                    (0x02U)
+#define SIM_MSTATUS_MIE                         (0x08U)
+#define SIM_MSTATUS_MPIE                        (0x80U)
+#define SIM_IRQ_COUNT                           (64U)
+
+typedef struct {
+    uintptr_t Base;
+    uint32_t Size;
+    bool Trapped;                               /* Registers, every access goes through the models */
+    uint8_t *Shadow;                            /* Second mapping of the same memory, used by the models */
+} SIM_RegionTypeDef;
+
+typedef struct {
+    const char *Name;
+    uint32_t Value;
+} SIM_CsrTypeDef;
+
+typedef void (*SIM_HandlerTypeDef)(void);
+
+static SIM_RegionTypeDef SIM_Regions[] = {
+    {FLASH_BASE, 0x4000U, false, NULL_PTR},
+    {0x1FFFF000UL, 0x1000U, true, NULL_PTR},    /* ESIG and option bytes, programmed through the FLASH model */
+    {SRAM_BASE, 0x1000U, false, NULL_PTR},
+    {PERIPH_BASE, 0x24000U, true, NULL_PTR},
+    {0xE000E000UL, 0x2000U, true, NULL_PTR},    /* PFIC and SysTick */
+};
+
+static SIM_CsrTypeDef SIM_Csr[] = {
+    {"mstatus", SIM_MSTATUS_MIE | SIM_MSTATUS_MPIE},
+    {"misa", 0x40000014UL},                     /* RV32EC */
+    {"mtvec", 0U},
+    {"mscratch", 0U},
+    {"mepc", 0U},
+    {"mcause", 0U},
+    {"mvendorid", 0U},
+    {"marchid", 0U},
+    {"mimpid", 0U},
+    {"mhartid", 0U},
+};
+
+extern "C" {
+void NMI_Handler(void) __attribute__((weak));
+void HardFault_Handler(void) __attribute__((weak));
+void SysTick_Handler(void) __attribute__((weak));
+void SW_Handler(void) __attribute__((weak));
+void WWDG_IRQHandler(void) __attribute__((weak));
+void PVD_IRQHandler(void) __attribute__((weak));
+void FLASH_IRQHandler(void) __attribute__((weak));
+void RCC_IRQHandler(void) __attribute__((weak));
+void EXTI7_0_IRQHandler(void) __attribute__((weak));
+void AWU_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel1_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel2_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel3_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel4_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel5_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel6_IRQHandler(void) __attribute__((weak));
+void DMA1_Channel7_IRQHandler(void) __attribute__((weak));
+void ADC1_IRQHandler(void) __attribute__((weak));
+void I2C1_EV_IRQHandler(void) __attribute__((weak));
+void I2C1_ER_IRQHandler(void) __attribute__((weak));
+void USART1_IRQHandler(void) __attribute__((weak));
+void SPI1_IRQHandler(void) __attribute__((weak));
+void TIM1_BRK_IRQHandler(void) __attribute__((weak));
+void TIM1_UP_IRQHandler(void) __attribute__((weak));
+void TIM1_TRG_COM_IRQHandler(void) __attribute__((weak));
+void TIM1_CC_IRQHandler(void) __attribute__((weak));
+void TIM2_IRQHandler(void) __attribute__((weak));
+}
+
+/* Same layout as the vector table of the startup code */
+static const SIM_HandlerTypeDef SIM_Vectors[] = {
+    NULL_PTR, NULL_PTR, NMI_Handler, HardFault_Handler, NULL_PTR, NULL_PTR, NULL_PTR, NULL_PTR,
+    NULL_PTR, NULL_PTR, NULL_PTR, NULL_PTR, SysTick_Handler, NULL_PTR, SW_Handler, NULL_PTR,
+    WWDG_IRQHandler, PVD_IRQHandler, FLASH_IRQHandler, RCC_IRQHandler, EXTI7_0_IRQHandler, AWU_IRQHandler,
+    DMA1_Channel1_IRQHandler, DMA1_Channel2_IRQHandler, DMA1_Channel3_IRQHandler, DMA1_Channel4_IRQHandler,
+    DMA1_Channel5_IRQHandler, DMA1_Channel6_IRQHandler, DMA1_Channel7_IRQHandler, ADC1_IRQHandler,
+    I2C1_EV_IRQHandler, I2C1_ER_IRQHandler, USART1_IRQHandler, SPI1_IRQHandler, TIM1_BRK_IRQHandler,
+    TIM1_UP_IRQHandler, TIM1_TRG_COM_IRQHandler, TIM1_CC_IRQHandler, TIM2_IRQHandler
+};
+
+/* The startup code is not simulated, applications without ch32v00x_system.c read 0 */
+extern "C" {
+uint32_t SystemStartupCycles __attribute__((weak)) = 0U;
+uint32_t SystemCtorCycles __attribute__((weak)) = 0U;
+}
+
+static uint64_t SIM_Cycles = 0U;
+static uint64_t SIM_TickCycles = 0U;
+static uint64_t SIM_IrqEnabled = 0U;
+static uint64_t SIM_IrqPending = 0U;
+static uint64_t SIM_IrqActive = 0U;
+static uint32_t SIM_IrqDepth = 0U;
+static uint8_t SIM_IrqLevel[4];
+static long SIM_PageSize;
+
+static struct {
+    bool Active;
+    bool Write;
+    uintptr_t Address;
+    uint32_t Old;
+} SIM_Access;
+
+static ucontext_t SIM_HostContext;
+static ucontext_t SIM_AppContext;
+static int SIM_ExitCode = 0;
+
+static void SIM_Fatal(const char *message) {
+    fprintf(stderr, "[sim] %s\n", message);
+    exit(EXIT_FAILURE);
+}
+
+static SIM_RegionTypeDef *SIM_FindRegion(uintptr_t address) {
+    for(uint32_t i = 0U; i < LENGTH(SIM_Regions); i++) {
+        if((address >= SIM_Regions[i].Base) && (address < (SIM_Regions[i].Base + SIM_Regions[i].Size)))
+            return &SIM_Regions[i];
+    }
+    return NULL_PTR;
+}
+
+/**
+ * @brief  Get the model side view of a simulated address.
+ * @param  address address in the target address space.
+ * @retval Pointer to the same memory without access trapping, null if the address is not simulated.
+ */
+uint8_t *SIM_Shadow(uintptr_t address) {
+    SIM_RegionTypeDef *region = SIM_FindRegion(address);
+    return (region != NULL_PTR) ? (region->Shadow + (address - region->Base)) : NULL_PTR;
+}
+
+template<typename T>
+static T &SIM_Reg(volatile T &reg) {
+    return *(T *)SIM_Shadow((uintptr_t)&reg);
+}
+
+/**
+ * @brief  Set an interrupt pending, as the peripheral event would do.
+ * @param  irq interrupt number.
+ * @retval None.
+ */
+void SIM_SetPendingIRQ(uint32_t irq) {
+    if(irq < SIM_IRQ_COUNT)
+        SIM_IrqPending |= 1ULL << irq;
+}
+
+static SIM_HandlerTypeDef SIM_GetHandler(uint32_t irq) {
+    for(uint32_t i = 0U; i < HAL_FAST_IRQ_COUNT; i++) {
+        if((SIM_Reg(NVIC->VTFADDR[i]) & 0x01U) && (SIM_Reg(NVIC->VTFIDR[i]) == irq))
+            return (SIM_HandlerTypeDef)(uintptr_t)(SIM_Reg(NVIC->VTFADDR[i]) & ~0x01UL);
+    }
+    return (irq < LENGTH(SIM_Vectors)) ? SIM_Vectors[irq] : NULL_PTR;
+}
+
+/**
+ * @brief  Drive a level sensitive interrupt line, e.g. a status flag and its enable bit.
+ * @param  irq interrupt number.
+ * @param  asserted true while the peripheral requests the interrupt.
+ * @retval None.
+ */
+void SIM_SetIRQLine(uint32_t irq, bool asserted) {
+    if(irq >= SIM_IRQ_COUNT)
+        return;
+    if(asserted)
+        SIM_IrqPending |= 1ULL << irq;
+    else
+        SIM_IrqPending &= ~(1ULL << irq);
+}
+
+/**
+ * @brief  Run the handlers of the pending interrupts allowed to preempt the current code.
+ * @note   Inside a handler only the interrupts of a higher preemption level (bit 7 of
+ *         the priority) are taken, as with the nesting enabled by the startup code.
+ * @retval None.
+ */
+static void SIM_Dispatch(void) {
+    while(1U) {
+        uint64_t ready = SIM_IrqPending & SIM_IrqEnabled;
+        uint32_t irq = SIM_IRQ_COUNT;
+        uint8_t priority = 0xFFU;
+        for(uint32_t i = 0U; ready; i++, ready >>= 1U) {
+            if((ready & 0x01U) && ((irq == SIM_IRQ_COUNT) || (SIM_Reg(NVIC->IPRIOR[i]) < priority))) {
+                irq = i;
+                priority = SIM_Reg(NVIC->IPRIOR[i]);
+            }
+        }
+        if(irq == SIM_IRQ_COUNT)
+            return;
+        if(SIM_IrqDepth == 0U) {
+            if(!(SIM_Csr[0].Value & SIM_MSTATUS_MIE))
+                return;
+        }
+        else if((SIM_IrqDepth >= LENGTH(SIM_IrqLevel)) || ((priority & 0x80U) >= SIM_IrqLevel[SIM_IrqDepth - 1U]))
+            return;
+
+        SIM_HandlerTypeDef handler = SIM_GetHandler(irq);
+        uint32_t mstatus = SIM_Csr[0].Value;
+        if(handler == NULL_PTR) {
+            fprintf(stderr, "[sim] interrupt %u has no handler\n", (unsigned)irq);
+            exit(EXIT_FAILURE);
+        }
+        SIM_IrqPending &= ~(1ULL << irq);
+        SIM_IrqActive |= 1ULL << irq;
+        SIM_IrqLevel[SIM_IrqDepth++] = priority & 0x80U;
+        SIM_Csr[0].Value = (mstatus & ~(SIM_MSTATUS_MIE | SIM_MSTATUS_MPIE)) | ((mstatus & SIM_MSTATUS_MIE) << 4U);
+        handler();
+        SIM_Csr[0].Value = mstatus;
+        SIM_IrqDepth--;
+        SIM_IrqActive &= ~(1ULL << irq);
+    }
+}
+
+/**
+ * @brief  Bring the SysTick counter up to date with the simulated time.
+ * @retval None.
+ */
+static void SIM_SysTickUpdate(void) {
+    SysTick_Type &tick = SIM_Reg(*SysTick);
+    uint32_t div = (tick.CTLR & STK_CTLR_STCLK) ? 1U : 8U;
+    uint64_t ticks = (SIM_Cycles - SIM_TickCycles) / div;
+    if(!(tick.CTLR & STK_CTLR_STE)) {
+        SIM_TickCycles = SIM_Cycles;
+        return;
+    }
+    if(ticks == 0U)
+        return;
+    SIM_TickCycles += ticks * div;
+    uint32_t count = tick.CNT;
+    uint32_t distance = tick.CMP - count;
+    if((ticks > 0xFFFFFFFFULL) || ((distance != 0U) && (distance <= ticks))) {
+        tick.SR |= STK_SR_CNTIF;
+        if(tick.CTLR & STK_CTLR_STIE)
+            SIM_SetPendingIRQ(SysTicK_IRQn);
+        if(tick.CTLR & STK_CTLR_STRE) {
+            tick.CNT = (uint32_t)((ticks - distance) % ((uint64_t)tick.CMP + 1U));
+            return;
+        }
+    }
+    tick.CNT = count + (uint32_t)ticks;
+}
+
+static void SIM_CoreRead(uintptr_t address) {
+    uint32_t offset = address - (uintptr_t)NVIC;
+    SIM_SysTickUpdate();
+    if(offset < sizeof(NVIC->ISR))
+        SIM_Reg(NVIC->ISR[offset / 4U]) = (uint32_t)(SIM_IrqEnabled >> (32U * (offset / 4U)));
+    else if((offset -= sizeof(NVIC->ISR)) < sizeof(NVIC->IPR))
+        SIM_Reg(NVIC->IPR[offset / 4U]) = (uint32_t)(SIM_IrqPending >> (32U * (offset / 4U)));
+    else if((address & ~0x1FUL) == (uintptr_t)&NVIC->IACTR[0])
+        SIM_Reg(NVIC->IACTR[(address & 0x1FU) / 4U]) = (uint32_t)(SIM_IrqActive >> (32U * ((address & 0x1FU) / 4U)));
+    else if(address == (uintptr_t)&NVIC->GISR)
+        SIM_Reg(NVIC->GISR) = SIM_IrqDepth | (SIM_IrqDepth ? PFIC_GISR_GACTSTA : 0U) |
+                              ((SIM_IrqPending & SIM_IrqEnabled) ? PFIC_GISR_GPENDSTA : 0U);
+}
+
+static void SIM_CoreWrite(uintptr_t address, uint32_t old) {
+    uint32_t *reg = (uint32_t *)SIM_Shadow(address);
+    uint32_t index = (address & 0x1FU) / 4U;
+    if((address & ~0x1FUL) == (uintptr_t)&NVIC->IENR[0])
+        SIM_IrqEnabled |= (uint64_t)*reg << (32U * index);
+    else if((address & ~0x1FUL) == (uintptr_t)&NVIC->IRER[0])
+        SIM_IrqEnabled &= ~((uint64_t)*reg << (32U * index));
+    else if((address & ~0x1FUL) == (uintptr_t)&NVIC->IPSR[0])
+        SIM_IrqPending |= (uint64_t)*reg << (32U * index);
+    else if((address & ~0x1FUL) == (uintptr_t)&NVIC->IPRR[0])
+        SIM_IrqPending &= ~((uint64_t)*reg << (32U * index));
+    else if(address == (uintptr_t)&NVIC->CFGR) {
+        if(((*reg & PFIC_CFGR_KEYCODE) == NVIC_KEY3) && (*reg & PFIC_CFGR_SYSRESET)) {
+            fprintf(stderr, "[sim] software reset\n");
+            exit(SIM_EXIT_RESET);
+        }
+    }
+    else if(address == (uintptr_t)&NVIC->SCTLR) {
+        if(*reg & PFIC_SCTLR_SYSRESET) {
+            fprintf(stderr, "[sim] software reset\n");
+            exit(SIM_EXIT_RESET);
+        }
+    }
+    else if(address == (uintptr_t)&SysTick->CTLR) {
+        SIM_SysTickUpdate();
+        if(!(old & STK_CTLR_STE))
+            SIM_TickCycles = SIM_Cycles;
+        if(*reg & STK_CTLR_SWIE) {
+            *reg &= ~STK_CTLR_SWIE;
+            SIM_SetPendingIRQ(Software_IRQn);
+        }
+        return;
+    }
+    else if(address == (uintptr_t)&SysTick->CNT) {
+        SIM_TickCycles = SIM_Cycles;
+        return;
+    }
+    else
+        return;
+    if((address >= (uintptr_t)&NVIC->IENR[0]) && (address < (uintptr_t)&NVIC->IACTR[0]))
+        *reg = 0U;                              /* Write only registers */
+}
+
+/**
+ * @brief  Advance the simulated time and run the peripheral models.
+ * @param  cycles number of HCLK cycles, e.g. to account for the computations of a benchmark.
+ * @note   Interrupts raised meanwhile are taken before returning.
+ * @retval None.
+ */
+void SIM_Advance(uint32_t cycles) {
+    SIM_Cycles += cycles;
+    SIM_SysTickUpdate();
+    SIM_PeriphStep();
+    SIM_Dispatch();
+}
+
+/**
+ * @brief  Get the simulated time.
+ * @retval Number of HCLK cycles since the start of the simulation.
+ */
+uint64_t SIM_GetCycles(void) {
+    return SIM_Cycles;
+}
+
+static void SIM_PeripheralRead(uintptr_t address) {
+    if(address >= (uintptr_t)NVIC)
+        SIM_CoreRead(address);
+    else
+        SIM_PeriphRead(address);
+}
+
+static void SIM_PeripheralReadDone(uintptr_t address) {
+    if(address < (uintptr_t)NVIC)
+        SIM_PeriphReadDone(address);
+}
+
+static void SIM_PeripheralWrite(uintptr_t address, uint32_t old) {
+    if(address >= (uintptr_t)NVIC)
+        SIM_CoreWrite(address, old);
+    else
+        SIM_PeriphWrite(address, old);
+}
+
+/**
+ * @brief  Read from the target address space, for the DMA model.
+ * @param  address source address.
+ * @param  size access size in bytes (1, 2 or 4).
+ * @retval Value read.
+ */
+uint32_t SIM_BusRead(uint32_t address, uint32_t size) {
+    SIM_RegionTypeDef *region = SIM_FindRegion(address);
+    uint8_t *data = (region != NULL_PTR) ? SIM_Shadow(address) : (uint8_t *)(uintptr_t)address;
+    uint32_t value = 0U;
+    if((region != NULL_PTR) && region->Trapped)
+        SIM_PeripheralRead(address & ~0x03UL);
+    memcpy(&value, data, size);
+    if((region != NULL_PTR) && region->Trapped)
+        SIM_PeripheralReadDone(address & ~0x03UL);
+    return value;
+}
+
+/**
+ * @brief  Write to the target address space, for the DMA model.
+ * @param  address destination address.
+ * @param  size access size in bytes (1, 2 or 4).
+ * @param  value value to be written.
+ * @retval None.
+ */
+void SIM_BusWrite(uint32_t address, uint32_t size, uint32_t value) {
+    SIM_RegionTypeDef *region = SIM_FindRegion(address);
+    uint8_t *data = (region != NULL_PTR) ? SIM_Shadow(address) : (uint8_t *)(uintptr_t)address;
+    uint32_t old = 0U;
+    if(region != NULL_PTR)
+        memcpy(&old, SIM_Shadow(address & ~0x03UL), 4U);
+    memcpy(data, &value, size);
+    if((region != NULL_PTR) && region->Trapped)
+        SIM_PeripheralWrite(address & ~0x03UL, old);
+}
+
+/**
+ * @brief  First step of a register access, the page is opened for one instruction.
+ * @note   Reads are prepared before the instruction runs (e.g. the SysTick counter or
+ *         the received data are brought up to date), writes are handled after it.
+ */
+static void SIM_SegvHandler(int sig, siginfo_t *info, void *context) {
+    ucontext_t *uc = (ucontext_t *)context;
+    uintptr_t address = (uintptr_t)info->si_addr;
+    SIM_RegionTypeDef *region = SIM_FindRegion(address);
+    (void)sig;
+    if((region == NULL_PTR) || !region->Trapped || SIM_Access.Active) {
+        fprintf(stderr, "[sim] invalid access at %p\n", info->si_addr);
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+    SIM_Access.Active = true;
+    SIM_Access.Write = (uc->uc_mcontext.gregs[REG_ERR] & SIM_PAGE_FAULT_WRITE) != 0U;
+    SIM_Access.Address = address & ~0x03UL;
+    memcpy(&SIM_Access.Old, SIM_Shadow(SIM_Access.Address), 4U);
+    if(!SIM_Access.Write)
+        SIM_PeripheralRead(SIM_Access.Address);
+    mprotect((void *)(address & ~(uintptr_t)(SIM_PageSize - 1)), SIM_PageSize, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+/**
+ * @brief  Second step of a register access, after the instruction has run.
+ */
+static void SIM_TrapHandler(int sig, siginfo_t *info, void *context) {
+    ucontext_t *uc = (ucontext_t *)context;
+    (void)sig;
+    (void)info;
+    if(!SIM_Access.Active) {
+        signal(SIGTRAP, SIG_DFL);
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+    mprotect((void *)(SIM_Access.Address & ~(uintptr_t)(SIM_PageSize - 1)), SIM_PageSize, PROT_NONE);
+    SIM_Access.Active = false;
+    if(SIM_Access.Write)
+        SIM_PeripheralWrite(SIM_Access.Address, SIM_Access.Old);
+    else
+        SIM_PeripheralReadDone(SIM_Access.Address);
+    SIM_Advance(SIM_ACCESS_CYCLES);
+}
+
+/**
+ * @brief  Read an emulated CSR, used by core_riscv.h.
+ * @param  csr register name.
+ * @retval Register value.
+ */
+uint32_t SIM_ReadCSR(const char *csr) {
+    if(strcmp(csr, "sp") == 0)
+        return (uint32_t)(uintptr_t)__builtin_frame_address(0);
+    for(uint32_t i = 0U; i < LENGTH(SIM_Csr); i++) {
+        if(strcmp(csr, SIM_Csr[i].Name) == 0)
+            return SIM_Csr[i].Value;
+    }
+    return 0U;
+}
+
+/**
+ * @brief  Write an emulated CSR, used by core_riscv.h.
+ * @param  csr register name.
+ * @param  value new value.
+ * @note   Enabling the interrupts takes the pending ones. Writing sp is ignored.
+ * @retval None.
+ */
+void SIM_WriteCSR(const char *csr, uint32_t value) {
+    for(uint32_t i = 0U; i < LENGTH(SIM_Csr); i++) {
+        if(strcmp(csr, SIM_Csr[i].Name) == 0)
+            SIM_Csr[i].Value = value;
+    }
+    if(strcmp(csr, "mstatus") == 0)
+        SIM_Dispatch();
+}
+
+/**
+ * @brief  Sleep until an enabled interrupt is pending, used by core_riscv.h.
+ * @note   As on the core, the interrupt wakes up the CPU even if it is globally masked.
+ * @retval None.
+ */
+void SIM_WaitForInterrupt(void) {
+    uint64_t end = SIM_Cycles + SIM_WFI_TIMEOUT_CYCLES;
+    while(!(SIM_IrqPending & SIM_IrqEnabled) && (SIM_Cycles < end)) {
+        SIM_Cycles += SIM_ACCESS_CYCLES * 16U;
+        SIM_SysTickUpdate();
+        SIM_PeriphStep();
+    }
+    SIM_Dispatch();
+}
+
+/**
+ * @brief  Map the target address space at its real addresses and install the access traps.
+ * @retval None.
+ */
+static void SIM_Init(void) {
+    struct sigaction action;
+    if((uintptr_t)&SIM_Cycles > 0xFFFFFFFFUL)
+        SIM_Fatal("data above 4GB, the simulator must be linked with -no-pie");
+    SIM_PageSize = sysconf(_SC_PAGESIZE);
+    for(uint32_t i = 0U; i < LENGTH(SIM_Regions); i++) {
+        SIM_RegionTypeDef *region = &SIM_Regions[i];
+        int fd = memfd_create("ch32v00x_sim", 0);
+        if((fd < 0) || (ftruncate(fd, region->Size) != 0))
+            SIM_Fatal("cannot create the simulated memory");
+        void *target = mmap((void *)region->Base, region->Size, region->Trapped ? PROT_NONE : (PROT_READ | PROT_WRITE),
+                            MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+        region->Shadow = (uint8_t *)mmap(NULL_PTR, region->Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if((target != (void *)region->Base) || (region->Shadow == MAP_FAILED))
+            SIM_Fatal("cannot map the simulated memory at its target address");
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    action.sa_sigaction = SIM_SegvHandler;
+    sigaction(SIGSEGV, &action, NULL_PTR);
+    action.sa_sigaction = SIM_TrapHandler;
+    sigaction(SIGTRAP, &action, NULL_PTR);
+
+    SIM_PeriphReset();
+}
+
+static void SIM_AppEntry(void) {
+    SIM_ExitCode = SIM_AppMain();
+}
+
+/**
+ * @brief  Entry point of the simulator build.
+ * @note   The application main runs on a stack below 4GB, so the addresses it hands
+ *         to the peripherals (e.g. DMA buffers) fit in their 32 bits registers.
+ * @retval Exit code of the application main.
+ */
+int main(void) {
+    void *stack;
+    SIM_Init();
+    stack = mmap(NULL_PTR, SIM_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_STACK, -1, 0);
+    if(stack == MAP_FAILED)
+        SIM_Fatal("cannot allocate the application stack");
+    getcontext(&SIM_AppContext);
+    SIM_AppContext.uc_stack.ss_sp = stack;
+    SIM_AppContext.uc_stack.ss_size = SIM_STACK_SIZE;
+    SIM_AppContext.uc_link = &SIM_HostContext;
+    makecontext(&SIM_AppContext, SIM_AppEntry, 0);
+    swapcontext(&SIM_HostContext, &SIM_AppContext);
+    fflush(stdout);
+    return SIM_ExitCode;
+}
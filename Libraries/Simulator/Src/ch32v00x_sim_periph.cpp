@@ -0,0 +1,495 @@
+
+#include <string.h>
+#include <unistd.h>
+#include "ch32v00x_hal.h"
+#include "ch32v00x_sim.h"
+
+#define SIM_FLASH_SIZE                          (0x4000U)
+#define SIM_FLASH_KEY1                          (0x45670123UL)
+#define SIM_FLASH_KEY2                          (0xCDEF89ABUL)
+#define SIM_USART_RX_SIZE                       (256U)
+#define SIM_USART_TX_SIZE                       (1024U)
+#define SIM_DMA_CHANNELS                        (7U)
+#define SIM_ADC_CHANNELS                        (10U)
+
+typedef struct {
+    uint8_t Data[SIM_USART_RX_SIZE];
+    uint32_t Head;
+    uint32_t Tail;
+} SIM_QueueTypeDef;
+
+typedef struct {
+    uint32_t PADDR;
+    uint32_t MADDR;
+    uint32_t CNTR;
+} SIM_DmaStateTypeDef;
+
+typedef decltype(FLASH.REGS) SIM_FlashRegsTypeDef;
+typedef decltype(DMA1.REGS) SIM_DmaRegsTypeDef;
+typedef decltype(DMA1.CHANNEL1.REGS) SIM_DmaChannelRegsTypeDef;
+
+static uint32_t SIM_FlashKeyStep;
+static uint32_t SIM_ModeKeyStep;
+static uint32_t SIM_OptionKeyStep;
+static uint64_t SIM_FlashDone;
+
+static SIM_QueueTypeDef SIM_UsartRx;
+static uint8_t SIM_UsartTx[SIM_USART_TX_SIZE];
+static uint32_t SIM_UsartTxCount;
+static bool SIM_UsartEcho = true;
+static uint16_t SIM_UsartRxData;
+static uint64_t SIM_UsartTxDone;
+static uint64_t SIM_UsartRxNext;
+
+static SIM_SPIResponderTypeDef SIM_SpiResponder;
+static uint16_t SIM_SpiTxData;
+static uint16_t SIM_SpiRxData;
+static uint64_t SIM_SpiDone;
+
+static SIM_DmaStateTypeDef SIM_DmaState[SIM_DMA_CHANNELS];
+
+static uint16_t SIM_AdcInput[SIM_ADC_CHANNELS] = {512U, 512U, 512U, 512U, 512U, 512U, 512U, 512U, 512U, 512U};
+static uint64_t SIM_AdcDone;
+static bool SIM_AdcBusy;
+
+template<typename T>
+static T &SIM_View(T &regs) {
+    return *(T *)SIM_Shadow((uintptr_t)&regs);
+}
+
+static SIM_DmaChannelRegsTypeDef &SIM_DmaChannel(uint32_t index) {
+    return *(SIM_DmaChannelRegsTypeDef *)SIM_Shadow(DMA1_Channel1_BASE + (index * 0x14U));
+}
+
+/**
+ * @brief  Set the reset values of the registers and of the information block.
+ * @retval None.
+ */
+void SIM_PeriphReset(void) {
+    RCC_RegsTypeDef &rcc = SIM_View(*(RCC_RegsTypeDef *)RCC_BASE);
+    SIM_FlashRegsTypeDef &flash = SIM_View(FLASH.REGS);
+    uint16_t *ob = (uint16_t *)SIM_Shadow(UOB_BASE);
+    uint8_t *esig = SIM_Shadow(ESIG_BASE);
+    static const uint32_t uid[3U] = {0x3C4B5A69UL, 0x1E2D3C4BUL, 0xCDEF0123UL};
+
+    memset(SIM_Shadow(FLASH_BASE), 0xFF, SIM_FLASH_SIZE);
+    *(uint16_t *)esig = SIM_FLASH_SIZE / 1024U;
+    memcpy(esig + 8U, uid, sizeof(uid));
+    ob[0] = 0x5AA5U;                            /* Read protection disabled */
+    for(uint32_t i = 1U; i < 6U; i++)
+        ob[i] = 0x00FFU;
+
+    rcc.CTLR = RCC_CTLR_HSION | RCC_CTLR_HSIRDY;
+    rcc.RSTSCKR = RCC_RSTSCKR_PORRSTF;
+    flash.CTLR = FLASH_CTLR_LOCK | FLASH_CTLR_FLOCK;
+    flash.OBR = 0x03FCU & ~FLASH_OBR_RDPRT;
+    flash.WPR = 0xFFFFFFFFUL;
+    SIM_View(*(USART_RegsTypeDef *)USART1_BASE).STATR = USART_STATR_TXE | USART_STATR_TC;
+    SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE).STATR = SPI_STATR_TXE;
+}
+
+static void SIM_RccWrite(uintptr_t address) {
+    RCC_RegsTypeDef &rcc = SIM_View(*(RCC_RegsTypeDef *)RCC_BASE);
+    if(address == (uintptr_t)&((RCC_RegsTypeDef *)RCC_BASE)->CTLR) {
+        uint32_t ctlr = rcc.CTLR & ~(RCC_CTLR_HSIRDY | RCC_CTLR_HSERDY | RCC_CTLR_PLLRDY);
+        if(ctlr & RCC_CTLR_HSION)
+            ctlr |= RCC_CTLR_HSIRDY;
+        if(ctlr & RCC_CTLR_HSEON)
+            ctlr |= RCC_CTLR_HSERDY;
+        if(ctlr & RCC_CTLR_PLLON)
+            ctlr |= RCC_CTLR_PLLRDY;
+        rcc.CTLR = ctlr;
+    }
+    else if(address == (uintptr_t)&((RCC_RegsTypeDef *)RCC_BASE)->CFGR0)
+        rcc.CFGR0 = (rcc.CFGR0 & ~RCC_CFGR0_SWS) | ((rcc.CFGR0 & RCC_CFGR0_SW) << 2U);
+    else if(address == (uintptr_t)&((RCC_RegsTypeDef *)RCC_BASE)->RSTSCKR) {
+        uint32_t rstsckr = rcc.RSTSCKR & ~RCC_RSTSCKR_LSIRDY;
+        if(rstsckr & RCC_RSTSCKR_RMVF)
+            rstsckr &= ~(RCC_RSTSCKR_RMVF | RCC_RSTSCKR_PINRSTF | RCC_RSTSCKR_PORRSTF | RCC_RSTSCKR_SFTRSTF |
+                         RCC_RSTSCKR_IWDGRSTF | RCC_RSTSCKR_WWDGRSTF | RCC_RSTSCKR_LPWRRSTF);
+        if(rstsckr & RCC_RSTSCKR_LSION)
+            rstsckr |= RCC_RSTSCKR_LSIRDY;
+        rcc.RSTSCKR = rstsckr;
+    }
+}
+
+static void SIM_KeyStep(uint32_t &step, uint32_t key) {
+    step = (key == SIM_FLASH_KEY1) ? 1U : (((step == 1U) && (key == SIM_FLASH_KEY2)) ? 2U : 0U);
+}
+
+static void SIM_FlashErase(uint32_t address, uint32_t size) {
+    uint8_t *data = SIM_Shadow(address & ~(size - 1U));
+    if(data != NULL_PTR)
+        memset(data, 0xFF, size);
+}
+
+static void SIM_FlashStart(uint32_t ctlr) {
+    SIM_FlashRegsTypeDef &flash = SIM_View(FLASH.REGS);
+    uint32_t cycles = SIM_FLASH_PROGRAM_CYCLES;
+    if(ctlr & FLASH_CTLR_PER)
+        SIM_FlashErase(flash.ADDR, 1024U);
+    else if(ctlr & FLASH_CTLR_FTER)
+        SIM_FlashErase(flash.ADDR, 64U);
+    else if(ctlr & FLASH_CTLR_MER)
+        SIM_FlashErase(FLASH_BASE, SIM_FLASH_SIZE);
+    else if(ctlr & FLASH_CTLR_OBER)
+        SIM_FlashErase(UOB_BASE, 64U);
+    if(ctlr & (FLASH_CTLR_PER | FLASH_CTLR_FTER | FLASH_CTLR_MER | FLASH_CTLR_OBER))
+        cycles = SIM_FLASH_ERASE_CYCLES;
+    flash.STATR |= FLASH_STATR_BUSY;
+    SIM_FlashDone = SIM_GetCycles() + cycles;
+}
+
+static void SIM_FlashEnd(void) {
+    SIM_FlashRegsTypeDef &flash = SIM_View(FLASH.REGS);
+    flash.STATR = (flash.STATR & ~FLASH_STATR_BUSY) | FLASH_STATR_EOP;
+    if(flash.CTLR & FLASH_CTLR_EOPIE)
+        SIM_SetPendingIRQ(FLASH_IRQn);
+}
+
+static void SIM_FlashWrite(uintptr_t address, uint32_t old) {
+    SIM_FlashRegsTypeDef &flash = SIM_View(FLASH.REGS);
+    if(address == (uintptr_t)&FLASH.REGS.KEYR) {
+        SIM_KeyStep(SIM_FlashKeyStep, flash.KEYR);
+        if(SIM_FlashKeyStep == 2U)
+            flash.CTLR &= ~FLASH_CTLR_LOCK;
+        flash.KEYR = 0U;
+    }
+    else if(address == (uintptr_t)&FLASH.REGS.MODEKEYR) {
+        SIM_KeyStep(SIM_ModeKeyStep, flash.MODEKEYR);
+        if(SIM_ModeKeyStep == 2U)
+            flash.CTLR &= ~FLASH_CTLR_FLOCK;
+        flash.MODEKEYR = 0U;
+    }
+    else if(address == (uintptr_t)&FLASH.REGS.OBKEYR) {
+        SIM_KeyStep(SIM_OptionKeyStep, flash.OBKEYR);
+        if((SIM_OptionKeyStep == 2U) && !(flash.CTLR & FLASH_CTLR_LOCK))
+            flash.CTLR |= FLASH_CTLR_OBWRE;
+        flash.OBKEYR = 0U;
+    }
+    else if(address == (uintptr_t)&FLASH.REGS.STATR) {
+        uint32_t clear = flash.STATR & (FLASH_STATR_EOP | FLASH_STATR_WRPRTERR);
+        flash.STATR = old & ~clear;
+    }
+    else if(address == (uintptr_t)&FLASH.REGS.CTLR) {
+        /* LOCK and FLOCK are only cleared by the key sequences, OBWRE by the option key */
+        uint32_t ctlr = flash.CTLR | (old & (FLASH_CTLR_LOCK | FLASH_CTLR_FLOCK));
+        if(!(old & FLASH_CTLR_OBWRE))
+            ctlr &= ~FLASH_CTLR_OBWRE;
+        if(ctlr & FLASH_CTLR_LOCK)
+            ctlr &= ~FLASH_CTLR_OBWRE;
+        if(ctlr & (FLASH_CTLR_BUFRST | FLASH_CTLR_BUFLOAD)) {
+            ctlr &= ~(FLASH_CTLR_BUFRST | FLASH_CTLR_BUFLOAD); /* The page buffer operations complete at once */
+            flash.STATR |= FLASH_STATR_EOP;
+        }
+        if(ctlr & FLASH_CTLR_STRT) {
+            ctlr &= ~FLASH_CTLR_STRT;
+            if((ctlr & FLASH_CTLR_LOCK) || ((ctlr & FLASH_CTLR_OBER) && !(ctlr & FLASH_CTLR_OBWRE)))
+                flash.STATR |= FLASH_STATR_WRPRTERR;
+            else
+                SIM_FlashStart(ctlr);
+        }
+        flash.CTLR = ctlr;
+    }
+}
+
+static void SIM_OptionByteWrite(uintptr_t address, uint32_t old) {
+    SIM_FlashRegsTypeDef &flash = SIM_View(FLASH.REGS);
+    uint16_t *ob = (uint16_t *)SIM_Shadow(address);
+    uint32_t changed = *(uint32_t *)ob ^ old;
+    if(!(flash.CTLR & FLASH_CTLR_OBPG) || !(flash.CTLR & FLASH_CTLR_OBWRE)) {
+        *(uint32_t *)ob = old;
+        flash.STATR |= FLASH_STATR_WRPRTERR;
+        return;
+    }
+    for(uint32_t i = 0U; i < 2U; i++) {
+        if(changed & (0xFFFFUL << (16U * i)))
+            ob[i] = (uint16_t)((ob[i] & 0xFFU) | ((~ob[i] & 0xFFU) << 8U));
+    }
+    SIM_FlashStart(0U);
+}
+
+static void SIM_UsartWrite(uintptr_t address, uint32_t old) {
+    USART_RegsTypeDef &usart = SIM_View(*(USART_RegsTypeDef *)USART1_BASE);
+    USART_RegsTypeDef *regs = (USART_RegsTypeDef *)USART1_BASE;
+    if(address == (uintptr_t)&regs->STATR)
+        usart.STATR = old & (usart.STATR | ~(USART_STATR_TC | USART_STATR_RXNE)); /* Cleared by writing 0 */
+    else if(address == (uintptr_t)&regs->DATAR) {
+        if((usart.CTLR1 & (USART_CTLR1_UE | USART_CTLR1_TE)) != (USART_CTLR1_UE | USART_CTLR1_TE))
+            return;
+        uint8_t data = (uint8_t)usart.DATAR;
+        if(SIM_UsartTxCount < SIM_USART_TX_SIZE)
+            SIM_UsartTx[SIM_UsartTxCount++] = data;
+        if(SIM_UsartEcho)
+            (void)!write(STDOUT_FILENO, &data, 1U);
+        usart.STATR &= ~(USART_STATR_TXE | USART_STATR_TC);
+        SIM_UsartTxDone = SIM_GetCycles() + (usart.BRR * 10U);
+    }
+}
+
+static void SIM_SpiWrite(uintptr_t address, uint32_t old) {
+    SPI_RegsTypeDef &spi = SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE);
+    SPI_RegsTypeDef *regs = (SPI_RegsTypeDef *)SPI1_BASE;
+    if(address == (uintptr_t)&regs->STATR)
+        spi.STATR = old & (spi.STATR | ~SPI_STATR_CRCERR); /* Only CRCERR is writable, cleared by writing 0 */
+    else if(address == (uintptr_t)&regs->DATAR) {
+        if(!(spi.CTLR1 & SPI_CTLR1_SPE))
+            return;
+        uint32_t bits = (spi.CTLR1 & SPI_CTLR1_DFF) ? 16U : 8U;
+        SIM_SpiTxData = spi.DATAR;
+        spi.STATR = (spi.STATR & ~SPI_STATR_TXE) | SPI_STATR_BSY;
+        SIM_SpiDone = SIM_GetCycles() + (bits * (2U << ((spi.CTLR1 & SPI_CTLR1_BR) >> SPI_CTLR1_BR_Pos)));
+    }
+}
+
+static void SIM_AdcWrite(uintptr_t address, uint32_t old) {
+    ADC_RegsTypeDef &adc = SIM_View(*(ADC_RegsTypeDef *)ADC1_BASE);
+    ADC_RegsTypeDef *regs = (ADC_RegsTypeDef *)ADC1_BASE;
+    if(address == (uintptr_t)&regs->STATR)
+        adc.STATR &= old;                       /* Cleared by writing 0 */
+    else if(address == (uintptr_t)&regs->CTLR2) {
+        /* Setting ADON again or SWSTART starts a regular conversion */
+        if((adc.CTLR2 & ADC_CTLR2_ADON) && ((old & ADC_CTLR2_ADON) || (adc.CTLR2 & ADC_CTLR2_SWSTART))) {
+            adc.CTLR2 &= ~ADC_CTLR2_SWSTART;
+            SIM_AdcBusy = true;
+            SIM_AdcDone = SIM_GetCycles() + SIM_ADC_CONVERSION_CYCLES;
+        }
+    }
+}
+
+static void SIM_DmaWrite(uintptr_t address, uint32_t old) {
+    SIM_DmaRegsTypeDef &dma = SIM_View(DMA1.REGS);
+    if(address == (uintptr_t)&DMA1.REGS.INTFCR) {
+        dma.INTFR &= ~dma.INTFCR;
+        dma.INTFCR = 0U;
+        return;
+    }
+    for(uint32_t i = 0U; i < SIM_DMA_CHANNELS; i++) {
+        SIM_DmaChannelRegsTypeDef &channel = SIM_DmaChannel(i);
+        if((address == (uintptr_t)(DMA1_Channel1_BASE + (i * 0x14U))) && (channel.CFGR & DMA_CFGR_EN) && !(old & DMA_CFGR_EN)) {
+            SIM_DmaState[i].PADDR = channel.PADDR;
+            SIM_DmaState[i].MADDR = channel.MADDR;
+            SIM_DmaState[i].CNTR = channel.CNTR;
+        }
+    }
+}
+
+/**
+ * @brief  Model of a register write, called after the write instruction.
+ * @param  address register address, word aligned.
+ * @param  old register word before the write.
+ * @retval None.
+ */
+void SIM_PeriphWrite(uintptr_t address, uint32_t old) {
+    if((address >= UOB_BASE) && (address < (UOB_BASE + 0x40U)))
+        SIM_OptionByteWrite(address, old);
+    else if((address & ~0x3FFUL) == RCC_BASE)
+        SIM_RccWrite(address);
+    else if((address & ~0x3FFUL) == FLASH_R_BASE)
+        SIM_FlashWrite(address, old);
+    else if((address & ~0x3FFUL) == USART1_BASE)
+        SIM_UsartWrite(address, old);
+    else if((address & ~0x3FFUL) == SPI1_BASE)
+        SIM_SpiWrite(address, old);
+    else if((address & ~0x3FFUL) == DMA1_BASE)
+        SIM_DmaWrite(address, old);
+    else if((address & ~0x3FFUL) == ADC1_BASE)
+        SIM_AdcWrite(address, old);
+}
+
+/**
+ * @brief  Model of a register read, called before the read instruction.
+ * @param  address register address, word aligned.
+ * @retval None.
+ */
+void SIM_PeriphRead(uintptr_t address) {
+    if(address == (uintptr_t)&((USART_RegsTypeDef *)USART1_BASE)->DATAR)
+        SIM_View(*(USART_RegsTypeDef *)USART1_BASE).DATAR = SIM_UsartRxData;
+    else if(address == (uintptr_t)&((SPI_RegsTypeDef *)SPI1_BASE)->DATAR)
+        SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE).DATAR = SIM_SpiRxData;
+}
+
+/**
+ * @brief  Model of the side effects of a register read, called after the read instruction.
+ * @param  address register address, word aligned.
+ * @retval None.
+ */
+void SIM_PeriphReadDone(uintptr_t address) {
+    if(address == (uintptr_t)&((USART_RegsTypeDef *)USART1_BASE)->DATAR)
+        SIM_View(*(USART_RegsTypeDef *)USART1_BASE).STATR &= ~(USART_STATR_RXNE | USART_STATR_ORE);
+    else if(address == (uintptr_t)&((SPI_RegsTypeDef *)SPI1_BASE)->DATAR)
+        SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE).STATR &= ~SPI_STATR_RXNE;
+}
+
+static void SIM_UsartStep(uint64_t now) {
+    USART_RegsTypeDef &usart = SIM_View(*(USART_RegsTypeDef *)USART1_BASE);
+    if(!(usart.STATR & USART_STATR_TC) && (now >= SIM_UsartTxDone)) {
+        usart.STATR |= USART_STATR_TXE | USART_STATR_TC;
+    }
+    if((SIM_UsartRx.Head != SIM_UsartRx.Tail) && (now >= SIM_UsartRxNext) &&
+       ((usart.CTLR1 & (USART_CTLR1_UE | USART_CTLR1_RE)) == (USART_CTLR1_UE | USART_CTLR1_RE))) {
+        if(usart.STATR & USART_STATR_RXNE)
+            usart.STATR |= USART_STATR_ORE;
+        else
+            SIM_UsartRxData = SIM_UsartRx.Data[SIM_UsartRx.Tail++ % SIM_USART_RX_SIZE];
+        usart.STATR |= USART_STATR_RXNE;
+        SIM_UsartRxNext = now + (usart.BRR * 10U);
+    }
+    SIM_SetIRQLine(USART1_IRQn, ((usart.CTLR1 & USART_CTLR1_TXEIE) && (usart.STATR & USART_STATR_TXE)) ||
+                                ((usart.CTLR1 & USART_CTLR1_TCIE) && (usart.STATR & USART_STATR_TC)) ||
+                                ((usart.CTLR1 & USART_CTLR1_RXNEIE) && (usart.STATR & (USART_STATR_RXNE | USART_STATR_ORE))));
+}
+
+static void SIM_SpiStep(uint64_t now) {
+    SPI_RegsTypeDef &spi = SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE);
+    if((spi.STATR & SPI_STATR_BSY) && (now >= SIM_SpiDone)) {
+        if(spi.STATR & SPI_STATR_RXNE)
+            spi.STATR |= SPI_STATR_OVR;
+        else
+            SIM_SpiRxData = (SIM_SpiResponder != NULL_PTR) ? SIM_SpiResponder(SIM_SpiTxData) : SIM_SpiTxData;
+        spi.STATR = (spi.STATR & ~SPI_STATR_BSY) | SPI_STATR_TXE | SPI_STATR_RXNE;
+    }
+    SIM_SetIRQLine(SPI1_IRQn, ((spi.CTLR2 & SPI_CTLR2_TXEIE) && (spi.STATR & SPI_STATR_TXE)) ||
+                              ((spi.CTLR2 & SPI_CTLR2_RXNEIE) && (spi.STATR & SPI_STATR_RXNE)));
+}
+
+static void SIM_AdcStep(uint64_t now) {
+    ADC_RegsTypeDef &adc = SIM_View(*(ADC_RegsTypeDef *)ADC1_BASE);
+    if(SIM_AdcBusy && (now >= SIM_AdcDone)) {
+        uint32_t channel = (adc.RSQR3 & ADC_RSQR3_SQ1) >> ADC_RSQR3_SQ1_Pos;
+        SIM_AdcBusy = false;
+        adc.RDATAR = (channel < SIM_ADC_CHANNELS) ? SIM_AdcInput[channel] : 0U;
+        adc.STATR |= ADC_STATR_EOC;
+    }
+    SIM_SetIRQLine(ADC_IRQn, (adc.CTLR1 & ADC_CTLR1_EOCIE) && (adc.STATR & ADC_STATR_EOC));
+}
+
+static bool SIM_DmaRequest(uint32_t index, uint32_t cfgr) {
+    USART_RegsTypeDef &usart = SIM_View(*(USART_RegsTypeDef *)USART1_BASE);
+    SPI_RegsTypeDef &spi = SIM_View(*(SPI_RegsTypeDef *)SPI1_BASE);
+    if(cfgr & DMA_CFGR_MEM2MEM)
+        return true;
+    switch(index + 1U) {
+        case 2U:
+            return (spi.CTLR2 & SPI_CTLR2_RXDMAEN) && (spi.STATR & SPI_STATR_RXNE);
+        case 3U:
+            return (spi.CTLR2 & SPI_CTLR2_TXDMAEN) && (spi.STATR & SPI_STATR_TXE) && (spi.CTLR1 & SPI_CTLR1_SPE);
+        case 4U:
+            return (usart.CTLR3 & USART_CTLR3_DMAT) && (usart.STATR & USART_STATR_TXE);
+        case 5U:
+            return (usart.CTLR3 & USART_CTLR3_DMAR) && (usart.STATR & USART_STATR_RXNE);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief  Transfer one data on each channel with an active request.
+ * @note   The interrupt line reflects the flags of the previous transfers, it is updated at the next step.
+ * @note   The flags of channel n are at bits 4 * (n - 1) of INTFR, as GIF1, TCIF1, HTIF1 and TEIF1.
+ */
+static void SIM_DmaStep(void) {
+    SIM_DmaRegsTypeDef &dma = SIM_View(DMA1.REGS);
+    for(uint32_t i = 0U; i < SIM_DMA_CHANNELS; i++) {
+        SIM_DmaChannelRegsTypeDef &channel = SIM_DmaChannel(i);
+        SIM_DmaStateTypeDef &state = SIM_DmaState[i];
+        uint32_t cfgr = channel.CFGR;
+        uint32_t enabled = ((cfgr & DMA_CFGR_TCIE) ? DMA_INTFR_TCIF1 : 0U) | ((cfgr & DMA_CFGR_HTIE) ? DMA_INTFR_HTIF1 : 0U) |
+                           ((cfgr & DMA_CFGR_TEIE) ? DMA_INTFR_TEIF1 : 0U);
+        SIM_SetIRQLine(DMA1_Channel1_IRQn + i, ((dma.INTFR >> (4U * i)) & enabled) != 0U);
+        if(!(cfgr & DMA_CFGR_EN) || (channel.CNTR == 0U) || !SIM_DmaRequest(i, cfgr))
+            continue;
+        uint32_t psize = 1U << ((cfgr & DMA_CFGR_PSIZE) >> DMA_CFGR_PSIZE_Pos);
+        uint32_t msize = 1U << ((cfgr & DMA_CFGR_MSIZE) >> DMA_CFGR_MSIZE_Pos);
+        uint32_t flags = 0U;
+        if(cfgr & DMA_CFGR_DIR)
+            SIM_BusWrite(state.PADDR, psize, SIM_BusRead(state.MADDR, msize));
+        else
+            SIM_BusWrite(state.MADDR, msize, SIM_BusRead(state.PADDR, psize));
+        if(cfgr & DMA_CFGR_PINC)
+            state.PADDR += psize;
+        if(cfgr & DMA_CFGR_MINC)
+            state.MADDR += msize;
+        channel.CNTR = channel.CNTR - 1U;
+        if(channel.CNTR == (state.CNTR / 2U))
+            flags |= DMA_INTFR_HTIF1;
+        if(channel.CNTR == 0U) {
+            flags |= DMA_INTFR_TCIF1;
+            if(cfgr & DMA_CFGR_CIRC) {
+                channel.CNTR = state.CNTR;
+                state.PADDR = channel.PADDR;
+                state.MADDR = channel.MADDR;
+            }
+        }
+        if(flags)
+            dma.INTFR |= (flags | DMA_INTFR_GIF1) << (4U * i);
+    }
+}
+
+/**
+ * @brief  Run the peripheral models up to the current simulated time.
+ * @retval None.
+ */
+void SIM_PeriphStep(void) {
+    uint64_t now = SIM_GetCycles();
+    if((SIM_View(FLASH.REGS).STATR & FLASH_STATR_BUSY) && (now >= SIM_FlashDone))
+        SIM_FlashEnd();
+    SIM_UsartStep(now);
+    SIM_SpiStep(now);
+    SIM_AdcStep(now);
+    SIM_DmaStep();
+}
+
+/**
+ * @brief  Queue bytes to be received by USART1, one per frame time.
+ * @param  data bytes to be received.
+ * @param  length number of bytes, the bytes not fitting in the queue are dropped.
+ * @retval None.
+ */
+void SIM_USART_Inject(const uint8_t *data, uint32_t length) {
+    for(uint32_t i = 0U; (i < length) && ((SIM_UsartRx.Head - SIM_UsartRx.Tail) < SIM_USART_RX_SIZE); i++)
+        SIM_UsartRx.Data[SIM_UsartRx.Head++ % SIM_USART_RX_SIZE] = data[i];
+}
+
+/**
+ * @brief  Get the bytes sent by USART1 since the previous call.
+ * @param  data buffer for the bytes.
+ * @param  length size of the buffer.
+ * @retval Number of bytes copied.
+ */
+uint32_t SIM_USART_Fetch(uint8_t *data, uint32_t length) {
+    uint32_t count = (length < SIM_UsartTxCount) ? length : SIM_UsartTxCount;
+    memcpy(data, SIM_UsartTx, count);
+    memmove(SIM_UsartTx, &SIM_UsartTx[count], SIM_UsartTxCount - count);
+    SIM_UsartTxCount -= count;
+    return count;
+}
+
+/**
+ * @brief  Enable or disable the copy of the bytes sent by USART1 to the standard output.
+ * @param  enabled true to print the bytes (default).
+ * @retval None.
+ */
+void SIM_USART_SetEcho(bool enabled) {
+    SIM_UsartEcho = enabled;
+}
+
+/**
+ * @brief  Set the SPI slave model.
+ * @param  responder function returning the frame received for each frame sent, null for a loopback.
+ * @retval None.
+ */
+void SIM_SPI_SetResponder(SIM_SPIResponderTypeDef responder) {
+    SIM_SpiResponder = responder;
+}
+
+/**
+ * @brief  Set the value converted by the ADC on a channel.
+ * @param  channel ADC channel.
+ * @param  value 10 bits conversion result, mid-scale by default.
+ * @retval None.
+ */
+void SIM_ADC_SetInput(uint32_t channel, uint16_t value) {
+    if(channel < SIM_ADC_CHANNELS)
+        SIM_AdcInput[channel] = value;
+}
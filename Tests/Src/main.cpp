@@ -0,0 +1,172 @@
+
+#include <stdio.h>
+#include "ch32v00x_hal.h"
+
+#ifndef HAL_SIMULATOR
+#error "The driver tests check the simulator peripheral models, build them with make test_sim"
+#endif /* HAL_SIMULATOR */
+
+#include "ch32v00x_sim.h"
+
+#define TEST_USART_BAUDRATE                     (115200U)
+#define TEST_FLASH_ADDR                         (FLASH_BASE + 0x3000U)  /*!< Not owned by any middleware on the simulator */
+#define TEST_TIMEOUT_MS                         (10U)
+
+constexpr RCC_ProfileTypeDef TEST_PROFILE = RCC_Profile(RCC_SYSCLKSRC_PLL);
+
+static uint32_t TEST_Failures;
+static uint32_t TEST_Src[16];
+static uint32_t TEST_Dest[16];
+static volatile bool TEST_FlashDone;
+static volatile HAL_StatusTypeDef TEST_FlashStatus;
+
+/**
+ * @brief  Print the result of one check and count the failures.
+ * @param  name name of the check.
+ * @param  passed true if the check passed.
+ * @retval None.
+ */
+static void TEST_Check(const char *name, bool passed) {
+    printf("%s %s\n", passed ? "PASS" : "FAIL", name);
+    if(!passed)
+        TEST_Failures++;
+}
+
+static void TEST_FlashCallback(HAL_StatusTypeDef status) {
+    TEST_FlashStatus = status;
+    TEST_FlashDone = true;
+}
+
+static bool TEST_IsErased(uint32_t address, uint32_t size) {
+    for(uint32_t i = 0U; i < size; i += 4U) {
+        if(*(const uint32_t *)(uintptr_t)(address + i) != 0xFFFFFFFFUL)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief  TXE and TC are cleared by a DATAR write and set again once the frame
+ *         (10 bits at the programmed baud rate) has been shifted out.
+ * @retval None.
+ */
+static void TEST_Usart(void) {
+    uint8_t data[2] = {0x55U, 0xAAU};
+    uint8_t fetched[2];
+    uint64_t start;
+
+    SIM_USART_SetEcho(false);
+    TEST_Check("usart_idle_txe_tc", (USART1.REGS.STATR & (USART_STATR_TXE | USART_STATR_TC)) == (USART_STATR_TXE | USART_STATR_TC));
+    start = SIM_GetCycles();
+    TEST_Check("usart_transmit", USART1.Transmit(data, 1U, TEST_TIMEOUT_MS) == HAL_OK);
+    TEST_Check("usart_busy_txe_tc", (USART1.REGS.STATR & (USART_STATR_TXE | USART_STATR_TC)) == 0U);
+    while(!(USART1.REGS.STATR & USART_STATR_TC));
+    TEST_Check("usart_frame_time", (SIM_GetCycles() - start) >= (USART1.REGS.BRR * 10U));
+    TEST_Check("usart_done_txe", (USART1.REGS.STATR & USART_STATR_TXE) != 0U);
+    TEST_Check("usart_transmit_2", USART1.Transmit(&data[1], 1U, TEST_TIMEOUT_MS) == HAL_OK);
+    while(!(USART1.REGS.STATR & USART_STATR_TC));
+    TEST_Check("usart_fetch", (SIM_USART_Fetch(fetched, 2U) == 2U) && (fetched[0] == data[0]) && (fetched[1] == data[1]));
+    SIM_USART_SetEcho(true);
+}
+
+/**
+ * @brief  Without responder MISO is connected to MOSI, full duplex transfers read back
+ *         the transmitted frames.
+ * @retval None.
+ */
+static void TEST_Spi(void) {
+    uint8_t tx[8] = {0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU};
+    uint8_t rx[8] = {0U};
+    bool match = true;
+
+    SIM_SPI_SetResponder(NULL_PTR);
+    TEST_Check("spi_transmit", SPI1.Transmit(tx, sizeof(tx), rx, sizeof(rx), TEST_TIMEOUT_MS) == HAL_OK);
+    for(uint32_t i = 0U; i < sizeof(tx); i++)
+        match = match && (rx[i] == tx[i]);
+    TEST_Check("spi_loopback", match);
+}
+
+/**
+ * @brief  CNTR counts the memory to memory requests down to 0, the channel is only
+ *         ready again once it has reached 0.
+ * @retval None.
+ */
+static void TEST_Dma(void) {
+    bool match = true;
+
+    for(uint32_t i = 0U; i < LENGTH(TEST_Src); i++)
+        TEST_Src[i] = i * 0x01010101UL;
+    TEST_Check("dma_memcopy_start", DMA1.CHANNEL1.MemCopy(TEST_Src, TEST_Dest, sizeof(TEST_Src), DMA_COPYMODE_NON_BLOCKING) == HAL_OK);
+    TEST_Check("dma_cntr_loaded", (DMA1.CHANNEL1.REGS.CNTR != 0U) && (DMA1.CHANNEL1.REGS.CNTR <= LENGTH(TEST_Src)));
+    TEST_Check("dma_busy", DMA1.CHANNEL1.GetStatus() != HAL_OK);
+    while(DMA1.CHANNEL1.GetStatus() != HAL_OK);
+    TEST_Check("dma_cntr_zero", DMA1.CHANNEL1.REGS.CNTR == 0U);
+    for(uint32_t i = 0U; i < LENGTH(TEST_Src); i++)
+        match = match && (TEST_Dest[i] == TEST_Src[i]);
+    TEST_Check("dma_data", match);
+}
+
+/**
+ * @brief  Erase and program set BUSY then EOP after the operation time, EOP raises the
+ *         FLASH interrupt when EOPIE is set and completes the asynchronous operations.
+ * @retval None.
+ */
+static void TEST_Flash(void) {
+    uint64_t start = SIM_GetCycles();
+    bool match = true;
+
+    TEST_Check("flash_erase", FLASH.ErasePage(TEST_FLASH_ADDR, FLASH_ERASE_1KB) == HAL_OK);
+    TEST_Check("flash_erase_time", (SIM_GetCycles() - start) >= SIM_FLASH_ERASE_CYCLES);
+    TEST_Check("flash_erased", TEST_IsErased(TEST_FLASH_ADDR, 1024U));
+    TEST_Check("flash_write", FLASH.WriteData(TEST_FLASH_ADDR, TEST_Src, sizeof(TEST_Src)) == HAL_OK);
+    for(uint32_t i = 0U; i < LENGTH(TEST_Src); i++)
+        match = match && (((const uint32_t *)TEST_FLASH_ADDR)[i] == TEST_Src[i]);
+    TEST_Check("flash_data", match);
+
+    TEST_FlashDone = false;
+    TEST_Check("flash_erase_async", FLASH.ErasePageAsync(TEST_FLASH_ADDR, FLASH_ERASE_1KB, TEST_FlashCallback) == HAL_OK);
+    TEST_Check("flash_erase_async_busy", FLASH.IsBusy() && !TEST_FlashDone);
+    while(!TEST_FlashDone)
+        __WFI();
+    TEST_Check("flash_erase_async_eop", (TEST_FlashStatus == HAL_OK) && !FLASH.IsBusy());
+    TEST_Check("flash_erase_async_erased", TEST_IsErased(TEST_FLASH_ADDR, 1024U));
+
+    TEST_FlashDone = false;
+    TEST_Check("flash_write_async", FLASH.WriteDataAsync(TEST_FLASH_ADDR, TEST_Src, sizeof(TEST_Src), TEST_FlashCallback) == HAL_OK);
+    while(!TEST_FlashDone)
+        __WFI();
+    match = (TEST_FlashStatus == HAL_OK);
+    for(uint32_t i = 0U; i < LENGTH(TEST_Src); i++)
+        match = match && (((const uint32_t *)TEST_FLASH_ADDR)[i] == TEST_Src[i]);
+    TEST_Check("flash_write_async_eop", match);
+}
+
+static void TEST_Init(void) {
+    HAL.Init();
+    RCC.SetProfile(TEST_PROFILE);
+
+    USART1.EnableClock();
+    USART1.BaudRate.SetValue<TEST_PROFILE.HCLK, TEST_USART_BAUDRATE>();
+    USART1.TxMode.Enable();
+    USART1.Enable();
+
+    SPI1.EnableClock();
+    SPI1.Mode.MasterFullDuplex();
+    SPI1.NSS.Disable();
+    SPI1.NSS.ActiveHight();
+    SPI1.Enable();
+
+    DMA1.EnableClock();
+    DMA1.CHANNEL1.SetMINC(ENABLE);
+    DMA1.CHANNEL1.SetPINC(ENABLE);
+}
+
+int main(void) {
+    TEST_Init();
+    TEST_Usart();
+    TEST_Spi();
+    TEST_Dma();
+    TEST_Flash();
+    printf("%lu failure(s)\n", (unsigned long)TEST_Failures);
+    return (TEST_Failures == 0U) ? 0 : 1;
+}
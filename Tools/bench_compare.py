@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Compare two benchmark tables and report the regressions.
+
+Usage:
+    bench_compare.py baseline.log current.log [threshold_percent]
+
+The logs are the USART output of the benchmark target (or of `make benchmark_sim`),
+only the last table between the "# hal-bench" and "# end" lines is used. A case is
+a regression when its cycles per call grew by more than the threshold (5% by
+default). The exit status is 1 if any case regressed.
+"""
+
+import sys
+
+
+def parse(path):
+    """Return the cycles per call of each case and the header line of the last table."""
+    tables = []
+    with open(path, errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith('# hal-bench'):
+                tables.append((line, {}))
+            elif tables and line and not line.startswith('#') and not line.startswith('name,'):
+                fields = line.split(',')
+                if len(fields) == 5 and fields[2].isdigit():
+                    tables[-1][1][fields[0]] = int(fields[2])
+    if not tables:
+        sys.exit('%s: no benchmark table found' % path)
+    return tables[-1]
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.exit(__doc__)
+    threshold = float(sys.argv[3]) if len(sys.argv) == 4 else 5.0
+    base_header, base = parse(sys.argv[1])
+    header, current = parse(sys.argv[2])
+    if base_header != header:
+        print('warning: the tables were not measured with the same setup (%s / %s)' % (base_header, header))
+
+    regressions = 0
+    print('%-20s %10s %10s %8s' % ('name', 'baseline', 'current', 'change'))
+    for name, cycles in current.items():
+        if name not in base:
+            print('%-20s %10s %10d %8s' % (name, '-', cycles, 'new'))
+            continue
+        change = ((cycles - base[name]) * 100.0 / base[name]) if base[name] else (100.0 if cycles else 0.0)
+        flag = ''
+        if change > threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+        print('%-20s %10d %10d %+7.1f%%%s' % (name, base[name], cycles, change, flag))
+    for name in base:
+        if name not in current:
+            print('%-20s %10d %10s %8s' % (name, base[name], '-', 'removed'))
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Report the static RAM used by each object file, from a GNU ld map file.
+
+Usage:
+    ram_report.py Build/DEBUG/Bin/CH32V003_HAL.map
+
+The sizes of the input sections placed in the RAM output sections (.ramfunc,
+.data, .noinit and .bss) are summed per object, library members included.
+"""
+
+import os
+import re
+import sys
+
+RAM_SECTIONS = ('.ramfunc', '.data', '.noinit', '.bss')
+COLUMNS = RAM_SECTIONS
+
+HEX_RE = re.compile(r'^0x[0-9a-fA-F]+$')
+
+
+def module_name(path):
+    member = re.match(r'(.*)\((.*)\)$', path)
+    if member:
+        return '%s(%s)' % (os.path.basename(member.group(1)), member.group(2))
+    return os.path.basename(path)
+
+
+def parse(lines):
+    """Return the RAM usage per module and per output section, the RAM length and the stack size."""
+    usage = {}
+    totals = dict.fromkeys(COLUMNS, 0)
+    ram = None
+    stack = 0
+    section = None
+    stage = None
+    for line in lines:
+        line = line.rstrip('\r\n')
+        if line.startswith('Memory Configuration'):
+            stage = 'memory'
+        elif line.startswith('Linker script and memory map'):
+            stage = 'map'
+        elif stage == 'memory':
+            fields = line.split()
+            if len(fields) >= 3 and fields[0] == 'RAM':
+                ram = int(fields[2], 16)
+        elif stage == 'map' and line:
+            fields = line.split()
+            if not line.startswith(' '):
+                # Output section, its address and size may be on the next line
+                section = fields[0]
+                if section == '.stack' and len(fields) >= 3:
+                    stack = int(fields[2], 16)
+                continue
+            if section == '.stack' and not stack and len(fields) >= 2 and HEX_RE.match(fields[1]):
+                stack = int(fields[1], 16)
+            if section not in RAM_SECTIONS or line.startswith(' *'):
+                continue
+            # Input section: " name addr size file", the name may be alone on the line before
+            if line[1] != ' ':
+                fields = fields[1:]
+            if len(fields) >= 3 and HEX_RE.match(fields[0]) and HEX_RE.match(fields[1]):
+                size = int(fields[1], 16)
+                if size:
+                    sizes = usage.setdefault(module_name(' '.join(fields[2:])), dict.fromkeys(COLUMNS, 0))
+                    sizes[section] += size
+                    totals[section] += size
+    return usage, totals, ram, stack
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    with open(sys.argv[1]) as f:
+        usage, totals, ram, stack = parse(f)
+
+    print('%-32s %8s %8s %8s %8s %8s' % (('module',) + COLUMNS + ('total',)))
+    for name, sizes in sorted(usage.items(), key=lambda item: -sum(item[1].values())):
+        print('%-32s %8d %8d %8d %8d %8d' % ((name[:32],) + tuple(sizes[c] for c in COLUMNS) + (sum(sizes.values()),)))
+    total = sum(totals.values())
+    print('%-32s %8d %8d %8d %8d %8d' % (('total',) + tuple(totals[c] for c in COLUMNS) + (total,)))
+    if ram:
+        print('\nstatic RAM %d + stack %d of %d bytes, %d bytes free' % (total, stack, ram, ram - total - stack))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Convert a TRACE stream captured from USART1 to the Chrome trace event format.
+
+Usage:
+    trace2json.py capture.bin [-n names.txt] [-o trace.json]
+
+The capture is the raw byte stream sent by the Trace middleware, e.g. from
+"stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > capture.bin".
+The names file maps event ids (0 to 63) to names, one "<id> <name>" per line.
+Open the output in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+KIND_INSTANT = 0x00
+KIND_BEGIN = 0x40
+KIND_END = 0x80
+EVENT_MASK = 0x3F
+
+EVENT_START = 0xFD
+EVENT_DROP = 0xFE
+EVENT_TIME = 0xFF
+START_MAGIC = 0xA5
+
+
+def find_start(data):
+    """Return the offset of the first start record, or 0 if there is none."""
+    for offset in range(len(data) - 3):
+        if data[offset] == EVENT_START and data[offset + 1] == START_MAGIC:
+            return offset
+    return 0
+
+
+def load_names(path):
+    names = {}
+    if path:
+        with open(path) as f:
+            for line in f:
+                line = line.split('#', 1)[0].split(None, 1)
+                if len(line) == 2:
+                    names[int(line[0], 0)] = line[1].strip()
+    return names
+
+
+def decode(data, names, ticks_per_ms):
+    events = []
+    time = 0.0
+    tick = 0
+    extra = 0
+    offset = find_start(data)
+    for event, arg, delta in struct.iter_unpack('<BBH', data[offset:len(data) - (len(data) - offset) % 4]):
+        if event == EVENT_TIME:
+            extra = delta << 16
+            continue
+        if event == EVENT_START:
+            # Sent by TRACE.Init, the delta field holds the tick rate. After a reset of
+            # the device the new timeline is appended to the previous one.
+            if arg == START_MAGIC and delta:
+                time += tick * 1000.0 / ticks_per_ms
+                tick = 0
+                ticks_per_ms = delta
+            events.append({'name': 'start', 'ph': 'i', 's': 'g', 'ts': time, 'pid': 0, 'tid': 0})
+            continue
+        tick += extra | delta
+        extra = 0
+        ts = time + tick * 1000.0 / ticks_per_ms
+        if event == EVENT_DROP:
+            events.append({'name': 'dropped', 'ph': 'i', 's': 'g', 'ts': ts, 'pid': 0, 'tid': 0,
+                           'args': {'records': arg}})
+        else:
+            kind = event & ~EVENT_MASK
+            name = names.get(event & EVENT_MASK, 'event%d' % (event & EVENT_MASK))
+            ph = {KIND_INSTANT: 'i', KIND_BEGIN: 'B', KIND_END: 'E'}.get(kind, 'i')
+            record = {'name': name, 'ph': ph, 'ts': ts, 'pid': 0, 'tid': 0, 'args': {'arg': arg}}
+            if ph == 'i':
+                record['s'] = 't'
+            events.append(record)
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('capture', help='raw capture file, - for stdin')
+    parser.add_argument('-n', '--names', help='event names file')
+    parser.add_argument('-o', '--output', help='output file, stdout by default')
+    parser.add_argument('-t', '--ticks-per-ms', type=int, default=6000,
+                        help='tick rate used until a start record is found (default: 6000, HCLK/8 at 48 MHz)')
+    args = parser.parse_args()
+
+    if args.capture == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, 'rb') as f:
+            data = f.read()
+    trace = {'traceEvents': decode(data, load_names(args.names), args.ticks_per_ms), 'displayTimeUnit': 'ns'}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(trace, f, indent=1)
+    else:
+        json.dump(trace, sys.stdout, indent=1)
+
+
+if __name__ == '__main__':
+    main()
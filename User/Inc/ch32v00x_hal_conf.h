@@ -14,4 +14,27 @@
  */
 #define HSE_STARTUP_TIMEOUT                     (0x2000U)       /* Time out for HSE start up */
 
+/**
+ * @brief HCLK frequencies (in Hz) with shift/add time conversions generated at compile time.
+ *        Any other HCLK value falls back to conversions using division.
+ */
+#define HAL_TICK_HCLK_LIST                      48000000U, 24000000U, 8000000U, 6000000U
+
+/**
+ * @brief Instrumentation of the HAL interrupt handlers (ch32v00x_hal_irqstats.h).
+ *        HAL_IRQ_STATS_HISTOGRAM keeps duration and latency histograms in RAM,
+ *        HAL_IRQ_STATS_GPIO drives HAL_IRQ_STATS_GPIO_PIN high while a handler runs
+ *        (the pin must be configured as output). HAL_IRQ_STATS_NONE compiles it out.
+ */
+#define HAL_IRQ_STATS                           HAL_IRQ_STATS_NONE
+#define HAL_IRQ_STATS_GPIO_PORT                 GPIOC
+#define HAL_IRQ_STATS_GPIO_PIN                  GPIO_PIN_0
+
+/**
+ * @brief Force-inline the trivial register accessors (ch32v00x_hal_<module>_inline.h)
+ *        instead of calling them out of line. Trades a few bytes per call site for
+ *        the call overhead.
+ */
+#define HAL_INLINE_ACCESSORS                    (0U)
+
 #endif /* __CH32V00x_HAL_CONF_H */
@@ -1,10 +1,33 @@
 
 #include "ch32v00x.h"
 
+#define SYSTEM_RCC_CTLR                         (*(__IO uint32_t *)(RCC_BASE + 0x00U))
+#define SYSTEM_RCC_CFGR0                        (*(__IO uint32_t *)(RCC_BASE + 0x04U))
+#define SYSTEM_FLASH_ACTLR                      (*(__IO uint32_t *)(FLASH_R_BASE + 0x00U))
+
+#define SYSTEM_SYSCLKSRC_PLL                    (0x02U)
+
+uint32_t SystemStartupCycles;
+uint32_t SystemCtorCycles;
+
 /**
  * @brief  Setup the microcontroller system.
+ * @note   Called by the startup code before .data is loaded and .bss is cleared,
+ *         so it must not use any global or static variable.
+ * @note   With SYSTEM_EARLY_CLOCK the system clock is switched to PLL (HSI x 2 = 48 MHz)
+ *         with HCLK undivided and one flash wait state. Nothing is done when the PLL
+ *         already drives the system clock, e.g. when started by the bootloader.
  * @retval None.
  */
 void SystemInit(void) {
-
+#ifdef SYSTEM_EARLY_CLOCK
+    if(((SYSTEM_RCC_CFGR0 & RCC_CFGR0_SWS) >> RCC_CFGR0_SWS_Pos) == SYSTEM_SYSCLKSRC_PLL)
+        return;
+    SYSTEM_FLASH_ACTLR = (SYSTEM_FLASH_ACTLR & ~FLASH_ACTLR_LATENCY) | (1U << FLASH_ACTLR_LATENCY_Pos);
+    SYSTEM_RCC_CFGR0 &= ~(RCC_CFGR0_HPRE | RCC_CFGR0_PLLSRC);
+    SYSTEM_RCC_CTLR |= RCC_CTLR_PLLON;
+    while(!(SYSTEM_RCC_CTLR & RCC_CTLR_PLLRDY));
+    SYSTEM_RCC_CFGR0 = (SYSTEM_RCC_CFGR0 & ~RCC_CFGR0_SW) | (SYSTEM_SYSCLKSRC_PLL << RCC_CFGR0_SW_Pos);
+    while(((SYSTEM_RCC_CFGR0 & RCC_CFGR0_SWS) >> RCC_CFGR0_SWS_Pos) != SYSTEM_SYSCLKSRC_PLL);
+#endif /* SYSTEM_EARLY_CLOCK */
 }
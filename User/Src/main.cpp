@@ -1,6 +1,7 @@
 
 #include "ch32v00x_hal.h"
 #include "stopwatch.h"
+#include "sched.h"
 
 void RCC_Init(void) {
     RCC.HSI.Enable();
@@ -16,12 +17,16 @@ void GPIO_Init(void) {
     GPIOC.WritePin(GPIO_PIN_ALL, GPIO_STATE_SET);
 }
 
+static void LED_Toggle(uint32_t param) {
+    (void)param;
+    GPIOC.TogglePin(GPIO_PIN_ALL);
+}
+
 int main(void) {
     HAL.Init();
     RCC_Init();
     GPIO_Init();
-    while(1) {
-        GPIOC.TogglePin(GPIO_PIN_ALL);
-        HAL.DelayMs(500);
-    }
+    SCHED.Init();
+    SCHED.StartTimer(LED_Toggle, 500U, 500U);
+    SCHED.Run();
 }
@@ -1,4 +1,8 @@
 
+#ifndef STACK_PAINT_PATTERN
+#define STACK_PAINT_PATTERN 0xA5A5A5A5
+#endif
+
 	.section  .init, "ax", @progbits
 	.globl  _start
 	.align  2
@@ -115,10 +119,35 @@ handle_reset:
 1:
 	la sp, _eusrstack
 2:
-	/* Load data section from flash to RAM */
+    /* Clock bring-up runs first so that the copy loops below already run at full speed.
+       SystemInit must not use .data or .bss, they are not initialized yet */
+    jal   SystemInit
+
+    /* Free-running SysTick at HCLK, counts the startup cycles up to main */
+    li t0, 0xE000F000
+    sw zero, 8(t0)
+    li t1, 0x5                  /* STK_CTLR_STE | STK_CTLR_STCLK */
+    sw t1, 0(t0)
+
+	/* Load ramfunc and data sections from flash to RAM, 4 words per iteration */
 	la a0, _data_lma
 	la a1, _data_vma
 	la a2, _edata
+	addi a3, a2, -12
+	bgeu a1, a3, 3f
+1:
+	lw t0, 0(a0)
+	lw t1, 4(a0)
+	lw t2, 8(a0)
+	lw a4, 12(a0)
+	sw t0, 0(a1)
+	sw t1, 4(a1)
+	sw t2, 8(a1)
+	sw a4, 12(a1)
+	addi a0, a0, 16
+	addi a1, a1, 16
+	bltu a1, a3, 1b
+3:
 	bgeu a1, a2, 2f
 1:
 	lw t0, (a0)
@@ -127,15 +156,80 @@ handle_reset:
 	addi a1, a1, 4
 	bltu a1, a2, 1b
 2:
-    /* clear bss section */
+    /* clear bss section, 4 words per iteration. .noinit lies outside and is left untouched */
     la a0, _sbss
     la a1, _ebss
+    addi a2, a1, -12
+    bgeu a0, a2, 3f
+1:
+    sw zero, 0(a0)
+    sw zero, 4(a0)
+    sw zero, 8(a0)
+    sw zero, 12(a0)
+    addi a0, a0, 16
+    bltu a0, a2, 1b
+3:
     bgeu a0, a1, 2f
 1:
     sw zero, (a0)
     addi a0, a0, 4
     bltu a0, a1, 1b
 2:
+#ifdef STACK_PAINT
+    /* Paint the free RAM and the stack with a pattern, see the StackMon middleware */
+    la a0, _ebss
+    la a1, _eusrstack
+    li t0, STACK_PAINT_PATTERN
+    addi a2, a1, -12
+    bgeu a0, a2, 3f
+1:
+    sw t0, 0(a0)
+    sw t0, 4(a0)
+    sw t0, 8(a0)
+    sw t0, 12(a0)
+    addi a0, a0, 16
+    bltu a0, a2, 1b
+3:
+    bgeu a0, a1, 2f
+1:
+    sw t0, (a0)
+    addi a0, a0, 4
+    bltu a0, a1, 1b
+2:
+#endif
+    /* C++ static constructors, .preinit_array then .init_array. The linker script sorts
+       .init_array by init_priority, lower values run first */
+    li t0, 0xE000F000
+    lw t0, 8(t0)
+    la t1, SystemCtorCycles
+    sw t0, (t1)
+    la s0, __preinit_array_start
+    la s1, __preinit_array_end
+    bgeu s0, s1, 2f
+1:
+    lw t0, (s0)
+    jalr t0
+    addi s0, s0, 4
+    bltu s0, s1, 1b
+2:
+    la s0, __init_array_start
+    la s1, __init_array_end
+    bgeu s0, s1, 2f
+1:
+    lw t0, (s0)
+    jalr t0
+    addi s0, s0, 4
+    bltu s0, s1, 1b
+2:
+    li t0, 0xE000F000
+    lw t0, 8(t0)
+    la t1, SystemCtorCycles
+    lw t2, (t1)
+    sub t2, t0, t2
+    sw t2, (t1)
+    la t1, SystemStartupCycles
+    sw t0, (t1)
+
     li t0, 0x80
     csrw mstatus, t0
 
@@ -146,7 +240,6 @@ handle_reset:
     ori t0, t0, 3
     csrw mtvec, t0
 
-    jal   SystemInit
     la t0, main
     csrw mepc, t0
     mret